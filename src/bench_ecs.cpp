@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include "core/World.hpp"
+#include "core/components/PositionComponent.hpp"
+#include "core/components/VelocityComponent.hpp"
+#include "core/components/SpriteComponent.hpp"
+#include "core/components/ProjectileComponent.hpp"
+#include "core/components/LifetimeComponent.hpp"
+#include "core/components/HealthComponent.hpp"
+
+using namespace game::core;
+using namespace game::core::components;
+
+/**
+ * ECS microbenchmark
+ *
+ * Runs the access pattern of ProjectileSystem::update (query projectiles,
+ * fetch their components, query players and fetch theirs for every
+ * projectile) against:
+ * - LegacyRegistry: storages in an unordered_map keyed by type_index,
+ *   get<T>() looks the type up twice (hasStorage + getStorage), the query
+ *   once per entity and component (the registry before ComponentTypeID)
+ * - ComponentRegistry: flat array indexed by ComponentTypeID<T>
+ * The queries there go through World::getEntitiesWith, which is built on
+ * view(), so that speedup also measures the query path. The lookup pass
+ * after it calls only get<T>/has<T> over a fixed entity list, on the two
+ * registries directly, to isolate the storage lookup.
+ *
+ * Then runs the movement, collision and snapshot passes over 10k+
+ * entities with World's two storage backends (sparse sets and archetype
+ * chunks), after some churn so the sparse sets aren't in creation order.
+ */
+namespace {
+
+constexpr int PROJECTILES = 256;
+constexpr int PLAYERS = 32;
+constexpr int FRAMES = 2000;
+constexpr int LOOKUP_FRAMES = 20000;
+
+constexpr int BACKEND_ENTITIES = 12000;
+constexpr int BACKEND_FRAMES = 500;
+
+class LegacyRegistry {
+public:
+    template<typename T>
+    ComponentStorage<T>& getStorage() {
+        auto it = storages.find(std::type_index(typeid(T)));
+        if (it == storages.end()) {
+            auto wrapper = std::make_unique<ComponentStorageWrapper<T>>();
+            ComponentStorageWrapper<T>* wrapperPtr = wrapper.get();
+            storages[std::type_index(typeid(T))] = std::move(wrapper);
+            return wrapperPtr->getStorage();
+        }
+        return static_cast<ComponentStorageWrapper<T>*>(it->second.get())->getStorage();
+    }
+
+    template<typename T>
+    bool hasStorage() const {
+        return storages.find(std::type_index(typeid(T))) != storages.end();
+    }
+
+    template<typename T>
+    T* add(Entity::ID entity, const T& component) {
+        return getStorage<T>().add(entity, component);
+    }
+
+    template<typename T>
+    T* get(Entity::ID entity) {
+        if (!hasStorage<T>()) return nullptr;
+        return getStorage<T>().get(entity);
+    }
+
+    template<typename T>
+    bool has(Entity::ID entity) {
+        if (!hasStorage<T>()) return false;
+        return getStorage<T>().has(entity);
+    }
+
+    template<typename First, typename... Rest>
+    std::vector<Entity::ID> getEntitiesWith() {
+        std::vector<Entity::ID> result;
+        for (const auto& pair : getStorage<First>()) {
+            if ((has<Rest>(pair.first) && ...)) {
+                result.push_back(pair.first);
+            }
+        }
+        return result;
+    }
+
+private:
+    std::unordered_map<std::type_index, std::unique_ptr<IComponentStorage>> storages;
+};
+
+/**
+ * ComponentRegistry with World's query
+ */
+class FlatRegistry {
+public:
+    template<typename T>
+    T* add(Entity::ID entity, const T& component) {
+        return world.addComponent<T>(entity, component);
+    }
+
+    template<typename T>
+    T* get(Entity::ID entity) {
+        return world.getComponent<T>(entity);
+    }
+
+    template<typename... Components>
+    std::vector<Entity::ID> getEntitiesWith() const {
+        return world.getEntitiesWith<Components...>();
+    }
+
+private:
+    World world;
+};
+
+template<typename Registry>
+void populate(Registry& registry) {
+    Entity::ID id = 0;
+    for (int i = 0; i < PLAYERS; ++i, ++id) {
+        registry.add(id, PositionComponent(static_cast<float>(i * 40), 25.0f));
+        registry.add(id, SpriteComponent(sf::Vector2f(16.0f, 16.0f)));
+        registry.add(id, HealthComponent(10.0f));
+        registry.add(id, VelocityComponent());
+    }
+    for (int i = 0; i < PROJECTILES; ++i, ++id) {
+        registry.add(id, PositionComponent(static_cast<float>(i), static_cast<float>(i % 50)));
+        registry.add(id, VelocityComponent());
+        registry.add(id, SpriteComponent(sf::Vector2f(4.0f, 4.0f)));
+        registry.add(id, ProjectileComponent(static_cast<game::EntityID>(i % PLAYERS), 1.0f, 300.0f, sf::Vector2f(1.0f, 0.0f)));
+        registry.add(id, LifetimeComponent(1000.0f));
+    }
+}
+
+/**
+ * One ProjectileSystem-style frame; returns hits so nothing is optimized out
+ */
+template<typename Registry>
+int projectilePass(Registry& registry) {
+    int hits = 0;
+    const auto projectiles = registry.template getEntitiesWith<
+        PositionComponent, VelocityComponent, SpriteComponent, ProjectileComponent, LifetimeComponent>();
+    for (Entity::ID id : projectiles) {
+        auto* lifetime = registry.template get<LifetimeComponent>(id);
+        auto* pos = registry.template get<PositionComponent>(id);
+        auto* sprite = registry.template get<SpriteComponent>(id);
+        auto* projectile = registry.template get<ProjectileComponent>(id);
+        if (!lifetime || !pos || !sprite || !projectile) {
+            continue;
+        }
+        lifetime->currentLifetime += 0.0f;
+
+        const auto players = registry.template getEntitiesWith<PositionComponent, SpriteComponent, HealthComponent>();
+        for (Entity::ID playerID : players) {
+            if (playerID == projectile->ownerID) {
+                continue;
+            }
+            auto* playerPos = registry.template get<PositionComponent>(playerID);
+            auto* playerSprite = registry.template get<SpriteComponent>(playerID);
+            auto* playerHealth = registry.template get<HealthComponent>(playerID);
+            if (!playerPos || !playerSprite || !playerHealth) {
+                continue;
+            }
+            const float dx = pos->position.x - playerPos->position.x;
+            const float dy = pos->position.y - playerPos->position.y;
+            if (dx * dx + dy * dy < playerSprite->size.x * sprite->size.x) {
+                ++hits;
+            }
+        }
+    }
+    return hits;
+}
+
+template<typename Registry>
+double run(const char* name, long long& checksum) {
+    Registry registry;
+    populate(registry);
+    projectilePass(registry);  // Warm up
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        checksum += projectilePass(registry);
+    }
+    const double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    const double perFrame = microseconds / FRAMES;
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << perFrame << " us/frame" << std::endl;
+    return perFrame;
+}
+
+/**
+ * get<T>/has<T> only, no queries: every populated entity in a fixed
+ * shuffled order; returns a checksum so nothing is optimized out
+ */
+template<typename Registry>
+double lookupPass(Registry& registry, const std::vector<Entity::ID>& entities) {
+    double sum = 0.0;
+    for (Entity::ID id : entities) {
+        if (auto* pos = registry.template get<PositionComponent>(id)) {
+            sum += pos->position.x;
+        }
+        if (auto* sprite = registry.template get<SpriteComponent>(id)) {
+            sum += sprite->size.x;
+        }
+        if (registry.template has<HealthComponent>(id)) {
+            sum += 1.0;
+        }
+        if (registry.template has<ProjectileComponent>(id)) {
+            sum += 2.0;
+        }
+    }
+    return sum;
+}
+
+template<typename Registry>
+double runLookup(const char* name, double& checksum) {
+    Registry registry;
+    populate(registry);
+    std::vector<Entity::ID> entities;
+    for (Entity::ID id = 0; id < static_cast<Entity::ID>(PLAYERS + PROJECTILES); ++id) {
+        entities.push_back(id);
+    }
+    std::shuffle(entities.begin(), entities.end(), std::mt19937(11));
+    lookupPass(registry, entities);  // Warm up
+
+    const auto start = std::chrono::steady_clock::now();
+    double sum = 0.0;
+    for (int frame = 0; frame < LOOKUP_FRAMES; ++frame) {
+        sum += lookupPass(registry, entities);
+    }
+    const double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    const double perFrame = microseconds / LOOKUP_FRAMES;
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << perFrame << " us/frame" << std::endl;
+    checksum += sum / LOOKUP_FRAMES;
+    return perFrame;
+}
+
+/**
+ * Mix of players, projectiles and static props, created interleaved;
+ * then a third of the projectiles are replaced
+ */
+void populateBackend(World& world) {
+    std::mt19937 rng(7);
+    std::vector<Entity> projectiles;
+    auto spawn = [&](int kind) {
+        const Entity entity = world.createEntity();
+        const float x = static_cast<float>(rng() % 4096);
+        const float y = static_cast<float>(rng() % 4096);
+        world.addComponent(entity.id, PositionComponent(x, y));
+        if (kind == 0) {
+            world.addComponent(entity.id, SpriteComponent(sf::Vector2f(16.0f, 16.0f)));
+            world.addComponent(entity.id, HealthComponent(10.0f));
+            world.addComponent(entity.id, VelocityComponent(1.0f, 0.5f));
+        } else if (kind == 1) {
+            world.addComponent(entity.id, VelocityComponent(300.0f, 0.0f));
+            world.addComponent(entity.id, SpriteComponent(sf::Vector2f(4.0f, 4.0f)));
+            world.addComponent(entity.id, ProjectileComponent(0, 1.0f, 300.0f, sf::Vector2f(1.0f, 0.0f)));
+            world.addComponent(entity.id, LifetimeComponent(1000.0f));
+            projectiles.push_back(entity);
+        } else {
+            world.addComponent(entity.id, SpriteComponent(sf::Vector2f(32.0f, 32.0f)));
+        }
+    };
+    for (int i = 0; i < BACKEND_ENTITIES; ++i) {
+        spawn(static_cast<int>(rng() % 3));
+    }
+    std::shuffle(projectiles.begin(), projectiles.end(), rng);
+    for (size_t i = 0; i < projectiles.size() / 3; ++i) {
+        world.destroyEntity(projectiles[i]);
+        spawn(1);
+    }
+}
+
+/**
+ * MovementSystem, CollisionSystem and createSnapshot-style passes;
+ * returns a checksum so nothing is optimized out
+ */
+double backendFrame(World& world, std::vector<sf::Vector2f>& snapshot) {
+    world.view<PositionComponent, const VelocityComponent>().each(
+        [](Entity::ID, PositionComponent& pos, const VelocityComponent& vel) {
+            pos.position += vel.velocity * 0.016f;
+        });
+
+    world.view<const PositionComponent, VelocityComponent, const SpriteComponent>().each(
+        [](Entity::ID, const PositionComponent& pos, VelocityComponent& vel, const SpriteComponent& sprite) {
+            if (pos.position.x + sprite.size.x > 4096.0f || pos.position.x < 0.0f) {
+                vel.velocity.x = -vel.velocity.x;
+            }
+        });
+
+    snapshot.clear();
+    world.view<const PositionComponent, const SpriteComponent>().each(
+        [&snapshot](Entity::ID, const PositionComponent& pos, const SpriteComponent& sprite) {
+            snapshot.push_back(pos.position + sprite.size);
+        });
+
+    double sum = 0.0;
+    for (const sf::Vector2f& value : snapshot) {
+        sum += value.x;
+    }
+    return sum;
+}
+
+double runBackend(const char* name, StorageBackend backend, double& checksum) {
+    World world(backend);
+    populateBackend(world);
+    std::vector<sf::Vector2f> snapshot;
+    snapshot.reserve(BACKEND_ENTITIES);
+    backendFrame(world, snapshot);  // Warm up
+
+    const auto start = std::chrono::steady_clock::now();
+    double sum = 0.0;
+    for (int frame = 0; frame < BACKEND_FRAMES; ++frame) {
+        sum += backendFrame(world, snapshot);
+    }
+    const double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    const double perFrame = microseconds / BACKEND_FRAMES;
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << perFrame << " us/frame" << std::endl;
+    checksum += sum / BACKEND_FRAMES;
+    return perFrame;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== ECS Benchmark (ProjectileSystem access pattern) ===" << std::endl;
+    std::cout << PROJECTILES << " projectiles, " << PLAYERS << " players, " << FRAMES << " frames" << std::endl;
+
+    long long checksum = 0;
+    const double legacy = run<LegacyRegistry>("type_index map registry", checksum);
+    const double flat = run<FlatRegistry>("ComponentTypeID registry", checksum);
+
+    std::cout << "Speedup: " << std::setprecision(2) << legacy / flat << "x"
+              << " (checksum " << checksum << ")" << std::endl;
+    std::cout << "(includes the query path: World::getEntitiesWith is built on view())" << std::endl;
+
+    std::cout << std::endl << "=== Component lookup (get/has only, no queries) ===" << std::endl;
+    std::cout << (PLAYERS + PROJECTILES) << " entities x 4 lookups, " << LOOKUP_FRAMES << " frames" << std::endl;
+
+    double lookupChecksum = 0.0;
+    const double legacyLookup = runLookup<LegacyRegistry>("type_index map registry", lookupChecksum);
+    const double flatLookup = runLookup<ComponentRegistry>("ComponentTypeID registry", lookupChecksum);
+
+    std::cout << "Speedup: " << std::setprecision(2) << legacyLookup / flatLookup << "x"
+              << " (checksum " << lookupChecksum << ")" << std::endl;
+
+    std::cout << std::endl << "=== Storage backends (movement + collision + snapshot passes) ===" << std::endl;
+    std::cout << BACKEND_ENTITIES << " entities, " << BACKEND_FRAMES << " frames" << std::endl;
+
+    double sparseChecksum = 0.0;
+    double archetypeChecksum = 0.0;
+    const double sparse = runBackend("Sparse-set backend", StorageBackend::SparseSet, sparseChecksum);
+    const double archetype = runBackend("Archetype backend", StorageBackend::Archetype, archetypeChecksum);
+
+    std::cout << "Speedup: " << std::setprecision(2) << sparse / archetype << "x"
+              << " (checksums " << sparseChecksum << " / " << archetypeChecksum << ")" << std::endl;
+    return 0;
+}
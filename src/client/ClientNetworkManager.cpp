@@ -1,15 +1,19 @@
 #include "ClientNetworkManager.hpp"
 #include "../network/PacketTypes.hpp"
+#include "../network/Bundle.hpp"
 #include <SFML/System/Vector2.hpp>
 #include <iostream>
 #include <chrono>
+#include <algorithm>
 
 namespace game::client {
 
 ClientNetworkManager::ClientNetworkManager() 
     : connected(false)
-    , entityID(0)
-    , nextSequenceNumber(1) {
+    , latestSnapshotSequence(0)
+    , nextInputTick(1)
+    , pendingInputs(0) {
+    bundle.writeHeader(game::network::PacketType::BUNDLE);
 }
 
 ClientNetworkManager::~ClientNetworkManager() {
@@ -41,47 +45,76 @@ bool ClientNetworkManager::connect(const std::string& serverIp, uint16_t serverP
     }
     
     serverAddress = game::network::Address(serverIp, serverPort);
+    reliable.reset();
+    snapshotHistory.clear();
+    latestSnapshotSequence = 0;
+    fragmentAssembler.reset();
+    nextInputTick = 1;
+    pendingInputs = 0;
+    bundle.writeHeader(game::network::PacketType::BUNDLE);
+    heartbeatDue = false;
+    pendingSnapshotAck = 0;
     
     // Send CONNECT packet with initial position
-    game::network::Packet packet(game::network::PacketType::CONNECT);
-    packet.setSequence(nextSequenceNumber++);
-    packet.setTimestamp(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()
-    ).count()));
-    
-    // Send initial position to server
-    packet.write(initialPosition.x);
-    packet.write(initialPosition.y);
-    
-    if (!sendPacket(packet)) {
+    connectPosition = initialPosition;
+    connectAttempts = 0;
+    if (!sendConnect()) {
         std::cerr << "Failed to send CONNECT packet" << std::endl;
         return false;
     }
     
     std::cout << "Connecting to server " << serverAddress.toString() << "..." << std::endl;
     
-    // Wait for CONNECT_ACK (non-blocking, will be processed in processPackets)
+    // Wait for CONNECT_ACK (non-blocking, will be processed in processPackets;
+    // CONNECT is repeated there until it arrives)
     connected = false;  // Will be set to true when we receive CONNECT_ACK
+    connecting = true;
     
     return true;
 }
 
+bool ClientNetworkManager::sendConnect() {
+    game::network::Packet packet(game::network::PacketType::CONNECT);
+    
+    // Padding: the server only answers requests at least as large as its
+    // CHALLENGE, so it can't be used to amplify spoofed traffic
+    while (packet.getSize() < game::network::MIN_CONNECT_SIZE) {
+        packet.write(uint8_t(0));
+    }
+    
+    ++connectAttempts;
+    lastConnectAttempt = std::chrono::steady_clock::now();
+    return sendPacket(packet);
+}
+
+bool ClientNetworkManager::sendChallengeResponse() {
+    game::network::Packet packet(game::network::PacketType::CHALLENGE_RESPONSE);
+    packet.write(cookieWindow);
+    packet.write(cookieMac);
+    
+    // Send initial position to server
+    packet.write(connectPosition.x);
+    packet.write(connectPosition.y);
+    packet.write(maxSnapshotRate);  // The server adapts below this to our link
+    
+    return sendPacket(packet);
+}
+
 void ClientNetworkManager::disconnect() {
+    connecting = false;
     if (!connected) {
         return;
     }
     
-    // Send DISCONNECT packet
-    game::network::Packet packet(game::network::PacketType::DISCONNECT);
-    packet.setSequence(nextSequenceNumber++);
-    packet.setTimestamp(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()
-    ).count()));
-    
-    sendPacket(packet);
+    // Send DISCONNECT packet; nothing will be around to resend it, so send
+    // a few copies (the server's timeout covers the case where all are lost)
+    for (int i = 0; i < DISCONNECT_REDUNDANCY; ++i) {
+        game::network::Packet packet(game::network::PacketType::DISCONNECT);
+        sendPacket(packet);
+    }
     
     connected = false;
-    entityID = 0;
+    entity = game::core::Entity();
     
     std::cout << "Disconnected from server" << std::endl;
 }
@@ -119,10 +152,97 @@ int ClientNetworkManager::processPackets() {
         }
     }
     
+    const auto now = std::chrono::steady_clock::now();
+    
+    // Give up on fragment sets whose missing pieces never arrived
+    fragmentAssembler.expire(now);
+    
+    // CONNECT_ACK is reliable once the server knows us, but the handshake
+    // packets before it may be lost: start over until we're in
+    if (connecting && !connected) {
+        if (connectAttempts >= MAX_CONNECT_ATTEMPTS) {
+            std::cerr << "No response from server " << serverAddress.toString() << std::endl;
+            connecting = false;
+        } else if (std::chrono::duration<float>(now - lastConnectAttempt).count() >= CONNECT_RETRY_INTERVAL) {
+            sendConnect();
+        }
+    }
+    
     return packetCount;
 }
 
-bool ClientNetworkManager::sendPacket(const game::network::Packet& packet) {
+bool ClientNetworkManager::flush() {
+    if (!connected) {
+        return false;
+    }
+    
+    if (pendingSnapshotAck != 0) {
+        // Only the newest matters: the server never moves its baseline back
+        game::network::Packet ack(game::network::PacketType::SNAPSHOT_ACK);
+        ack.write(pendingSnapshotAck);
+        queue(ack);
+        pendingSnapshotAck = 0;
+    }
+    
+    if (heartbeatDue) {
+        game::network::Packet heartbeat(game::network::PacketType::HEARTBEAT);
+        uint32_t echoTimestamp = 0, holdMs = 0;
+        reliable.getTimeSync().getEcho(game::network::TimeSync::localTimeMs(), echoTimestamp, holdMs);
+        heartbeat.write(echoTimestamp);
+        heartbeat.write(holdMs);
+        queue(heartbeat);
+        heartbeatDue = false;
+    }
+    
+    // Messages that are new or due for a resend. The block must land in
+    // the bundle stamped next (the ack for it acks the messages), so it
+    // only takes the room left.
+    const auto now = std::chrono::steady_clock::now();
+    if (reliable.hasDueMessages(now)) {
+        if (bundle.getSize() > game::network::MAX_PACKET_SIZE / 2) {
+            sendBundle();
+        }
+        game::network::Packet messages(game::network::PacketType::MESSAGES);
+        reliable.writeMessages(messages, now, bundle.getSize() + game::network::BUNDLE_ENTRY_HEADER_SIZE - game::network::PacketHeader::SIZE);
+        game::network::BundleCodec::append(bundle, messages);
+    }
+    
+    return sendBundle();
+}
+
+bool ClientNetworkManager::queue(const game::network::Packet& message) {
+    if (game::network::BundleCodec::append(bundle, message)) {
+        return true;
+    }
+    sendBundle();
+    return game::network::BundleCodec::append(bundle, message);
+}
+
+bool ClientNetworkManager::sendBundle() {
+    if (bundle.getSize() <= game::network::PacketHeader::SIZE) {
+        return false;  // Nothing queued
+    }
+    const bool sent = sendPacket(bundle);
+    bundle.writeHeader(game::network::PacketType::BUNDLE);
+    return sent;
+}
+
+bool ClientNetworkManager::sendHeartbeat() {
+    if (!connected) {
+        return false;
+    }
+    heartbeatDue = true;
+    return true;
+}
+
+bool ClientNetworkManager::sendMessage(game::network::Channel channel, const game::network::Packet& message) {
+    return reliable.send(channel, message);
+}
+
+bool ClientNetworkManager::sendPacket(game::network::Packet& packet) {
+    // Sequence number and acks for everything received from the server
+    reliable.stampHeader(packet, std::chrono::steady_clock::now());
+    
     sf::Socket::Status status = socket.send(
         packet.getData(),
         static_cast<std::size_t>(packet.getSize()),
@@ -133,47 +253,163 @@ bool ClientNetworkManager::sendPacket(const game::network::Packet& packet) {
     return status == sf::Socket::Status::Done;
 }
 
-bool ClientNetworkManager::sendShoot(const sf::Vector2f& targetPosition) {
+const game::network::InputCommand& ClientNetworkManager::queueInput(const sf::Vector2f& velocity) {
+    game::network::InputCommand& command = inputHistory[nextInputTick % inputHistory.size()];
+    command.tick = nextInputTick++;
+    command.velocity = velocity;
+    pendingInputs = std::min(pendingInputs + 1, inputHistory.size());
+    return command;
+}
+
+bool ClientNetworkManager::flushInputs() {
+    if (!connected || pendingInputs == 0) {
+        return false;
+    }
+    
+    // New commands plus a few already sent, newest first
+    const uint32_t newestTick = nextInputTick - 1;
+    const size_t count = std::min<size_t>({
+        std::max(pendingInputs, game::network::INPUT_REDUNDANCY),
+        inputHistory.size(),
+        newestTick
+    });
+    game::network::InputCommand commands[game::network::MAX_INPUTS_PER_PACKET];
+    for (size_t i = 0; i < count; ++i) {
+        commands[i] = inputHistory[(newestTick - i) % inputHistory.size()];
+    }
+    
+    game::network::Packet packet(game::network::PacketType::INPUT);
+    game::network::InputCodec::write(packet, commands, count);
+    
+    pendingInputs = 0;
+    return queue(packet);
+}
+
+bool ClientNetworkManager::sendShoot(const sf::Vector2f& targetPosition, uint32_t viewTick) {
     if (!connected) {
         return false;
     }
     
     game::network::Packet packet(game::network::PacketType::SHOOT);
-    packet.setSequence(nextSequenceNumber++);
-    packet.setTimestamp(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()
-    ).count()));
     
     // Write target position (mouse world coordinates)
     packet.write(targetPosition.x);
     packet.write(targetPosition.y);
     
-    // Write player entity ID (for server validation)
-    packet.write(entityID);
+    // Write player entity handle (for server validation: a shot from an
+    // earlier entity with our ID must not fire for this one)
+    packet.write(entity.toHandle());
     
-    return sendPacket(packet);
+    // Server rewinds other players to this tick when resolving the shot
+    packet.write(viewTick);
+    
+    // Our input tick, for the server's weapon cooldown
+    packet.write(nextInputTick);
+    
+    return queue(packet);
 }
 
 void ClientNetworkManager::handlePacket(const game::network::Packet& packet) {
     game::network::PacketType type = packet.getType();
     
+    // Every server packet acks what we sent; messages are delivered before
+    // the rest of the payload (a snapshot may carry our CONNECT_ACK)
+    reliable.onPacketReceived(packet, std::chrono::steady_clock::now());
+    if (type == game::network::PacketType::SNAPSHOT || type == game::network::PacketType::MESSAGES) {
+        game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+        nonConstPacket.resetRead();
+        const bool valid = reliable.readMessages(nonConstPacket, [this](game::network::Packet& message) {
+            if (message.getType() != game::network::PacketType::MESSAGES &&
+                message.getType() != game::network::PacketType::SNAPSHOT) {
+                handlePacket(message);
+            }
+            return true;
+        });
+        if (!valid) {
+            return;
+        }
+    }
+    
     switch (type) {
         case game::network::PacketType::CONNECT_ACK: {
             game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
             nonConstPacket.resetRead();
-            game::core::Entity::ID receivedEntityID = 0;
-            if (nonConstPacket.read(receivedEntityID)) {
-                entityID = receivedEntityID;
+            game::core::Entity::Handle receivedHandle = 0;
+            if (nonConstPacket.read(receivedHandle)) {
+                sf::Vector2f mapSize;
+                if (nonConstPacket.read(mapSize.x) && nonConstPacket.read(mapSize.y)) {
+                    snapshotSpec = game::network::SnapshotSpec(mapSize);
+                }
+                entity = game::core::Entity::fromHandle(receivedHandle);
                 connected = true;
-                onConnectAck(entityID);
+                connecting = false;
+                onConnectAck(entity.id);
+            }
+            break;
+        }
+        
+        case game::network::PacketType::CHALLENGE: {
+            if (!connecting || connected) {
+                break;
+            }
+            game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+            nonConstPacket.resetRead();
+            if (nonConstPacket.read(cookieWindow) && nonConstPacket.read(cookieMac)) {
+                sendChallengeResponse();
+            }
+            break;
+        }
+        
+        case game::network::PacketType::CONNECT_REJECT: {
+            if (!connecting || connected) {
+                break;
+            }
+            game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+            nonConstPacket.resetRead();
+            uint8_t reason = 0;
+            nonConstPacket.read(reason);
+            if (static_cast<game::network::ConnectRejectReason>(reason) == game::network::ConnectRejectReason::SERVER_FULL) {
+                std::cerr << "Server " << serverAddress.toString() << " is full" << std::endl;
+            } else {
+                std::cerr << "Server " << serverAddress.toString() << " refused the connection" << std::endl;
             }
+            connecting = false;
             break;
         }
         
         case game::network::PacketType::SNAPSHOT: {
-            // Pass non-const reference for reading
+            if (!connected) {
+                break;  // Quantization spec arrives with CONNECT_ACK
+            }
+            // Read position is past the message block
+            game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+            handleSnapshot(nonConstPacket.getReadData(), nonConstPacket.getReadRemaining(), packet.getTimestamp());
+            break;
+        }
+        
+        case game::network::PacketType::SNAPSHOT_FRAGMENT: {
+            if (!connected) {
+                break;
+            }
+            game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+            nonConstPacket.resetRead();
+            if (fragmentAssembler.addFragment(nonConstPacket, std::chrono::steady_clock::now())) {
+                handleSnapshot(fragmentAssembler.getData(), fragmentAssembler.getSize(), packet.getTimestamp());
+            }
+            break;
+        }
+        
+        case game::network::PacketType::HEARTBEAT: {
+            // Server's answer to our heartbeat: RTT and clock offset sample
             game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
-            onSnapshot(nonConstPacket);
+            nonConstPacket.resetRead();
+            uint32_t echoTimestamp = 0, holdMs = 0;
+            if (nonConstPacket.read(echoTimestamp) && nonConstPacket.read(holdMs)) {
+                const uint32_t now = game::network::TimeSync::localTimeMs();
+                game::network::TimeSync& timeSync = reliable.getTimeSync();
+                timeSync.onEcho(packet.getTimestamp(), echoTimestamp, holdMs, now);
+                timeSync.onRemoteHeartbeat(packet.getTimestamp(), now);
+            }
             break;
         }
         
@@ -189,5 +425,29 @@ void ClientNetworkManager::handlePacket(const game::network::Packet& packet) {
     }
 }
 
+void ClientNetworkManager::handleSnapshot(const uint8_t* data, size_t size, uint32_t serverTime) {
+    game::network::BitReader reader(data, size);
+    if (!game::network::SnapshotCodec::readDelta(reader, snapshotHistory, snapshotSpec, decodedSnapshot)) {
+        return;  // Unknown baseline or truncated packet, server will resend from an older baseline
+    }
+    
+    if (decodedSnapshot.sequence <= latestSnapshotSequence) {
+        return;  // Late duplicate or reordered snapshot, already superseded
+    }
+    latestSnapshotSequence = decodedSnapshot.sequence;
+    
+    // Keep the decoded state as a future baseline (swap avoids a copy)
+    game::network::Snapshot& stored = snapshotHistory.insert(decodedSnapshot.sequence);
+    std::swap(stored.entities, decodedSnapshot.entities);
+    stored.tick = decodedSnapshot.tick;
+    stored.inputAck = decodedSnapshot.inputAck;
+    stored.serverTime = serverTime;
+    
+    // Acknowledge (with the next bundle) so the server can delta against this snapshot
+    pendingSnapshotAck = stored.sequence;
+    
+    onSnapshot(stored);
+}
+
 } // namespace game::client
 
@@ -4,6 +4,12 @@
 #include <SFML/System/Vector2.hpp>
 #include "../network/Address.hpp"
 #include "../network/Packet.hpp"
+#include "../network/Snapshot.hpp"
+#include "../network/Fragmentation.hpp"
+#include "../network/InputCommand.hpp"
+#include "../network/ReliableEndpoint.hpp"
+#include <array>
+#include <chrono>
 #include "../core/Entity.hpp"
 
 namespace game::client {
@@ -54,49 +60,158 @@ public:
     int processPackets();
     
     /**
-     * Send packet to server
+     * Send packet to server (stamps sequence number and acks)
      */
-    bool sendPacket(const game::network::Packet& packet);
+    bool sendPacket(game::network::Packet& packet);
     
     /**
-     * Send SHOOT packet to server
+     * Send this frame's BUNDLE: queued input, shots, snapshot ack,
+     * heartbeat and due messages in one datagram (call once per frame,
+     * after input and shots)
+     */
+    bool flush();
+    
+    /**
+     * Add a HEARTBEAT to the next bundle (keeps the connection alive; the
+     * server answers with its own HEARTBEAT, which gives an RTT and clock
+     * offset sample)
+     */
+    bool sendHeartbeat();
+    
+    /**
+     * Queue a message for the server; sent with the next flush()
+     */
+    bool sendMessage(game::network::Channel channel, const game::network::Packet& message);
+    
+    /**
+     * Record movement input for the next client tick (call once per fixed step)
+     * @return The queued command (tick assigned), for local prediction
+     */
+    const game::network::InputCommand& queueInput(const sf::Vector2f& velocity);
+    
+    /**
+     * Add queued input to the bundle as one INPUT entry, with the previous
+     * INPUT_REDUNDANCY commands repeated (call once per frame)
+     */
+    bool flushInputs();
+    
+    /**
+     * Add a SHOOT to the bundle
      * @param targetPosition Mouse world position (target for projectile)
+     * @param viewTick Server tick of the world state on screen (for lag compensation)
+     */
+    bool sendShoot(const sf::Vector2f& targetPosition, uint32_t viewTick);
+    
+    /**
+     * Tick the next input command will get (the client's current tick)
      */
-    bool sendShoot(const sf::Vector2f& targetPosition);
+    uint32_t getInputTick() const { return nextInputTick; }
     
     /**
      * Check if connected
      */
     bool isConnected() const { return connected; }
     
+    /**
+     * Highest snapshot rate to ask the server for (sent in the handshake)
+     */
+    void setMaxSnapshotRate(uint8_t rate) { maxSnapshotRate = rate; }
+    
     /**
      * Get assigned entity ID from server
      */
-    game::core::Entity::ID getEntityID() const { return entityID; }
+    game::core::Entity::ID getEntityID() const { return entity.id; }
     
     /**
      * Get server address
      */
     const game::network::Address& getServerAddress() const { return serverAddress; }
     
+    /**
+     * RTT, jitter and server clock offset
+     */
+    const game::network::TimeSync& getTimeSync() const { return reliable.getTimeSync(); }
+    
+    /**
+     * Snapshot fragment reassembly statistics
+     */
+    const game::network::FragmentStats& getFragmentStats() const { return fragmentAssembler.getStats(); }
+    
     /**
      * Callback for received packets (override in derived class or use function pointer)
      */
     virtual void onConnectAck(game::core::Entity::ID entityID) {}
-    virtual void onSnapshot(game::network::Packet& packet) {}  // Non-const for reading
+    virtual void onSnapshot(const game::network::Snapshot& snapshot) {}  // Full state, rebuilt from delta
     virtual void onDisconnect() {}
     
 private:
     sf::UdpSocket socket;
     game::network::Address serverAddress;
     bool connected;
-    game::core::Entity::ID entityID;
-    uint32_t nextSequenceNumber;
+    game::core::Entity entity;  // Handle from CONNECT_ACK
+    game::network::ReliableEndpoint reliable;  // Acks, RTT, message channels
+    
+    // Handshake: CONNECT → CHALLENGE (cookie) → CHALLENGE_RESPONSE → CONNECT_ACK;
+    // a retry starts over with CONNECT (cookies expire)
+    static constexpr float CONNECT_RETRY_INTERVAL = 0.5f;  // seconds
+    static constexpr int MAX_CONNECT_ATTEMPTS = 20;
+    static constexpr int DISCONNECT_REDUNDANCY = 3;
+    bool connecting = false;
+    int connectAttempts = 0;
+    sf::Vector2f connectPosition;
+    uint8_t maxSnapshotRate = 60;  // Advertised in CHALLENGE_RESPONSE
+    uint32_t cookieWindow = 0;     // From the last CHALLENGE
+    uint64_t cookieMac = 0;
+    std::chrono::steady_clock::time_point lastConnectAttempt;
+    
+    // Outgoing bundle, sent by flush() (or early when an entry doesn't fit)
+    game::network::Packet bundle;
+    bool heartbeatDue = false;        // Written at flush time (fresh echo hold time)
+    uint32_t pendingSnapshotAck = 0;  // Newest decoded snapshot, 0 = none to ack
+    
+    // Decoded snapshots (baselines for server deltas)
+    game::network::SnapshotHistory snapshotHistory;
+    game::network::Snapshot decodedSnapshot;  // Scratch, swapped into history
+    game::network::SnapshotSpec snapshotSpec;  // Quantization, map size from CONNECT_ACK
+    uint32_t latestSnapshotSequence;
+    game::network::FragmentAssembler fragmentAssembler;  // Snapshots larger than one datagram
+    
+    // Input history, newest at (nextInputTick - 1) % size
+    std::array<game::network::InputCommand, game::network::MAX_INPUTS_PER_PACKET> inputHistory;
+    uint32_t nextInputTick;
+    size_t pendingInputs;  // Queued since the last flush
     
     /**
      * Handle incoming packet
      */
     void handlePacket(const game::network::Packet& packet);
+    
+    /**
+     * Add a message to the bundle, sending the bundle first if it's full
+     */
+    bool queue(const game::network::Packet& message);
+    
+    /**
+     * Send the bundle if it has entries and start a new one
+     */
+    bool sendBundle();
+    
+    /**
+     * Send (or repeat) the CONNECT request
+     */
+    bool sendConnect();
+    
+    /**
+     * Echo the server's cookie with our connection details
+     */
+    bool sendChallengeResponse();
+    
+    /**
+     * Decode delta snapshot against local history and acknowledge it
+     * @param data Snapshot payload (single SNAPSHOT packet or reassembled fragments)
+     * @param serverTime Header timestamp of the (last) packet, server clock
+     */
+    void handleSnapshot(const uint8_t* data, size_t size, uint32_t serverTime);
 };
 
 } // namespace game::client
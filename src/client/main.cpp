@@ -19,32 +19,13 @@ public:
         std::cout << "[CLIENT] Received CONNECT_ACK, Entity ID: " << entityID << std::endl;
     }
     
-    void onSnapshot(game::network::Packet& packet) override {
-        packet.resetRead();
+    void onSnapshot(const game::network::Snapshot& snapshot) override {
+        std::cout << "[CLIENT] Received SNAPSHOT " << snapshot.sequence
+                  << " with " << snapshot.entities.size() << " entities" << std::endl;
         
-        uint32_t entityCount;
-        if (!packet.read(entityCount)) {
-            return;
-        }
-        
-        std::cout << "[CLIENT] Received SNAPSHOT with " << entityCount << " entities" << std::endl;
-        
-        // Read entities
-        for (uint32_t i = 0; i < entityCount; ++i) {
-            game::core::Entity::ID entityID;
-            if (!packet.read(entityID)) break;
-            
-            float posX, posY;
-            if (!packet.read(posX) || !packet.read(posY)) break;
-            
-            float sizeX, sizeY;
-            if (!packet.read(sizeX) || !packet.read(sizeY)) break;
-            
-            uint8_t r, g, b, a;
-            if (!packet.read(r) || !packet.read(g) || !packet.read(b) || !packet.read(a)) break;
-            
-            std::cout << "  Entity " << entityID << ": Position=(" << posX << ", " << posY 
-                      << "), Size=(" << sizeX << ", " << sizeY << ")" << std::endl;
+        for (const game::network::EntityState& state : snapshot.entities) {
+            std::cout << "  Entity " << state.id << ": Position=(" << state.position.x << ", " << state.position.y
+                      << "), Size=(" << state.size.x << ", " << state.size.y << ")" << std::endl;
         }
     }
     
@@ -99,15 +80,10 @@ int main(int argc, char* argv[]) {
         auto elapsed = std::chrono::duration<float>(now - lastHeartbeat).count();
         
         if (elapsed >= heartbeatInterval && client.isConnected()) {
-            game::network::Packet heartbeat(game::network::PacketType::HEARTBEAT);
-            heartbeat.setSequence(1);
-            heartbeat.setTimestamp(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
-                now.time_since_epoch()
-            ).count()));
-            
-            client.sendPacket(heartbeat);
+            client.sendHeartbeat();
             lastHeartbeat = now;
         }
+        client.flush();
         
         // Check for user input (non-blocking)
         // Note: Windows doesn't have easy non-blocking stdin, so we'll just keep running
@@ -0,0 +1,219 @@
+#include "ArchetypeStorage.hpp"
+
+namespace game::core {
+
+namespace {
+
+size_t alignUp(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// ========== Archetype ==========
+
+Archetype::Archetype(std::vector<ComponentInfo> columnInfos)
+    : infos(std::move(columnInfos)) {
+    signature.reserve(infos.size());
+    offsets.resize(infos.size());
+    for (size_t column = 0; column < infos.size(); ++column) {
+        const game::ComponentTypeID typeID = infos[column].typeID;
+        signature.push_back(typeID);
+        if (typeID >= columnOf.size()) {
+            columnOf.resize(typeID + 1, NO_COLUMN);
+        }
+        columnOf[typeID] = static_cast<int>(column);
+    }
+
+    // As many rows as fit in a chunk (alignment padding included), at
+    // least one for components bigger than a chunk
+    size_t rowBytes = sizeof(Entity::ID);
+    for (const ComponentInfo& info : infos) {
+        rowBytes += info.size;
+    }
+    capacity = std::max<size_t>(1, CHUNK_SIZE / rowBytes);
+    while (capacity > 1 && layout(capacity) > CHUNK_SIZE) {
+        --capacity;
+    }
+    chunkBytes = layout(capacity);
+}
+
+Archetype::~Archetype() {
+    clear();
+}
+
+size_t Archetype::layout(size_t rows) {
+    size_t offset = rows * sizeof(Entity::ID);
+    for (size_t column = 0; column < infos.size(); ++column) {
+        offset = alignUp(offset, infos[column].alignment);
+        offsets[column] = offset;
+        offset += rows * infos[column].size;
+    }
+    return offset;
+}
+
+size_t Archetype::pushRow(Entity::ID entity) {
+    const size_t row = count;
+    const size_t chunk = row / capacity;
+    if (chunk == chunks.size()) {
+        chunks.push_back(std::make_unique<std::byte[]>(chunkBytes));
+    }
+    getEntities(chunk)[row % capacity] = entity;
+    ++count;
+    return row;
+}
+
+Entity::ID Archetype::removeRow(size_t row) {
+    const size_t last = count - 1;
+    Entity::ID moved = INVALID_ENTITY;
+    for (size_t column = 0; column < infos.size(); ++column) {
+        const int col = static_cast<int>(column);
+        infos[column].destroy(at(col, row));
+        if (row != last) {
+            infos[column].moveConstruct(at(col, row), at(col, last));
+            infos[column].destroy(at(col, last));
+        }
+    }
+    if (row != last) {
+        moved = getEntity(last);
+        getEntities(row / capacity)[row % capacity] = moved;
+    }
+    --count;
+    return moved;
+}
+
+void Archetype::clear() {
+    for (size_t row = 0; row < count; ++row) {
+        for (size_t column = 0; column < infos.size(); ++column) {
+            infos[column].destroy(at(static_cast<int>(column), row));
+        }
+    }
+    count = 0;
+}
+
+// ========== ArchetypeStorage ==========
+
+void ArchetypeStorage::removeAll(Entity::ID entity) {
+    const Location from = locate(entity);
+    if (from.archetype == Archetype::NO_ARCHETYPE) {
+        return;
+    }
+    locations[entity] = Location();
+    leave(from);
+}
+
+void ArchetypeStorage::clear() {
+    for (auto& archetype : archetypes) {
+        archetype->clear();
+    }
+    locations.clear();
+}
+
+StorageMemoryUsage ArchetypeStorage::getMemoryUsage() const {
+    StorageMemoryUsage usage;
+    usage.total = locations.capacity() * sizeof(Location) + infos.capacity() * sizeof(ComponentInfo);
+    for (const auto& archetype : archetypes) {
+        const size_t bytes = archetype->getMemoryUsage();
+        usage.total += bytes;
+        usage.largest = std::max(usage.largest, bytes);
+    }
+    return usage;
+}
+
+void* ArchetypeStorage::find(Entity::ID entity, game::ComponentTypeID typeID) {
+    const Location location = locate(entity);
+    if (location.archetype == Archetype::NO_ARCHETYPE) {
+        return nullptr;
+    }
+    Archetype& archetype = *archetypes[location.archetype];
+    const int column = archetype.getColumn(typeID);
+    return column == Archetype::NO_COLUMN ? nullptr : archetype.at(column, location.row);
+}
+
+void ArchetypeStorage::registerType(const ComponentInfo& info) {
+    if (info.typeID >= infos.size()) {
+        infos.resize(info.typeID + 1);
+    }
+    if (infos[info.typeID].size == 0) {
+        infos[info.typeID] = info;
+    }
+}
+
+uint32_t ArchetypeStorage::transition(uint32_t archetype, game::ComponentTypeID typeID, bool add) {
+    if (archetype == Archetype::NO_ARCHETYPE) {
+        return findOrCreate({typeID});  // Only add starts from no components
+    }
+
+    Archetype& from = *archetypes[archetype];
+    const uint32_t cached = add ? from.getAddEdge(typeID) : from.getRemoveEdge(typeID);
+    if (cached != Archetype::NO_ARCHETYPE) {
+        return cached;
+    }
+
+    std::vector<game::ComponentTypeID> signature = from.getSignature();
+    if (add) {
+        signature.insert(std::lower_bound(signature.begin(), signature.end(), typeID), typeID);
+    } else {
+        signature.erase(std::lower_bound(signature.begin(), signature.end(), typeID));
+    }
+    const uint32_t to = signature.empty() ? EMPTY_SIGNATURE : findOrCreate(signature);
+
+    // findOrCreate may have grown archetypes; from is still valid (unique_ptr)
+    if (add) {
+        from.setAddEdge(typeID, to);
+    } else {
+        from.setRemoveEdge(typeID, to);
+    }
+    return to;
+}
+
+uint32_t ArchetypeStorage::findOrCreate(const std::vector<game::ComponentTypeID>& signature) {
+    for (size_t index = 0; index < archetypes.size(); ++index) {
+        if (archetypes[index]->getSignature() == signature) {
+            return static_cast<uint32_t>(index);
+        }
+    }
+
+    std::vector<ComponentInfo> columnInfos;
+    columnInfos.reserve(signature.size());
+    for (game::ComponentTypeID typeID : signature) {
+        columnInfos.push_back(infos[typeID]);
+    }
+    archetypes.push_back(std::make_unique<Archetype>(std::move(columnInfos)));
+    return static_cast<uint32_t>(archetypes.size() - 1);
+}
+
+size_t ArchetypeStorage::moveEntity(Entity::ID entity, const Location& from, uint32_t to, game::ComponentTypeID typeID) {
+    Archetype& destination = *archetypes[to];
+    const size_t row = destination.pushRow(entity);
+
+    if (from.archetype != Archetype::NO_ARCHETYPE) {
+        Archetype& source = *archetypes[from.archetype];
+        for (size_t column = 0; column < destination.getColumnCount(); ++column) {
+            const ComponentInfo& info = destination.getInfo(static_cast<int>(column));
+            if (info.typeID == typeID) {
+                continue;  // Added: constructed by the caller
+            }
+            info.moveConstruct(destination.at(static_cast<int>(column), row),
+                               source.at(source.getColumn(info.typeID), from.row));
+        }
+    }
+
+    if (entity >= locations.size()) {
+        locations.resize(entity + 1);
+    }
+    locations[entity] = Location{to, row};
+    return row;
+}
+
+void ArchetypeStorage::leave(const Location& from) {
+    if (from.archetype == Archetype::NO_ARCHETYPE) {
+        return;
+    }
+    const Entity::ID moved = archetypes[from.archetype]->removeRow(from.row);
+    if (moved != INVALID_ENTITY) {
+        locations[moved].row = from.row;
+    }
+}
+
+} // namespace game::core
@@ -0,0 +1,430 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <cassert>
+#include "Entity.hpp"
+#include "Component.hpp"
+#include "ComponentStorage.hpp"
+
+namespace game::core {
+
+/**
+ * Type-erased operations on one component type (what an archetype column
+ * needs to construct, move and destroy values it only knows by size)
+ */
+struct ComponentInfo {
+    game::ComponentTypeID typeID = 0;
+    size_t size = 0;
+    size_t alignment = 0;
+    const char* name = nullptr;
+    void (*moveConstruct)(void* destination, void* source) = nullptr;
+    void (*destroy)(void* value) = nullptr;
+
+    template<typename T>
+    static ComponentInfo of() {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned components don't fit chunk columns");
+        ComponentInfo info;
+        info.typeID = ComponentTypeID<T>::value();
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        info.name = componentName<T>();
+        info.moveConstruct = [](void* destination, void* source) {
+            new (destination) T(std::move(*static_cast<T*>(source)));
+        };
+        info.destroy = [](void* value) {
+            static_cast<T*>(value)->~T();
+        };
+        return info;
+    }
+};
+
+/**
+ * Archetype - Entities With One Component Signature
+ *
+ * Rows live in fixed-size chunks (CHUNK_SIZE bytes). Inside a chunk each
+ * component type has its own contiguous column, after the column of
+ * entity IDs:
+ *
+ *   [ID ID ID ...][Position Position ...][Velocity Velocity ...]
+ *
+ * Rows are packed: every chunk but the last is full, so row r is at
+ * chunk r / capacity, index r % capacity. Removing a row moves the last
+ * row into it.
+ */
+class Archetype {
+public:
+    static constexpr size_t CHUNK_SIZE = 16 * 1024;
+    static constexpr int NO_COLUMN = -1;
+
+    /**
+     * @param infos Component types of the signature, sorted by type ID
+     */
+    explicit Archetype(std::vector<ComponentInfo> infos);
+    ~Archetype();
+
+    // Non-copyable (rows are owned)
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    /**
+     * Component type IDs of the signature (sorted)
+     */
+    const std::vector<game::ComponentTypeID>& getSignature() const {
+        return signature;
+    }
+
+    /**
+     * Column of a component type, or NO_COLUMN if it isn't in the signature
+     */
+    int getColumn(game::ComponentTypeID typeID) const {
+        return typeID < columnOf.size() ? columnOf[typeID] : NO_COLUMN;
+    }
+
+    bool has(game::ComponentTypeID typeID) const {
+        return getColumn(typeID) != NO_COLUMN;
+    }
+
+    // ========== Rows ==========
+
+    size_t size() const { return count; }
+    size_t getChunkCapacity() const { return capacity; }
+
+    /**
+     * Chunks holding rows (chunks past the last row stay allocated for reuse)
+     */
+    size_t getChunkCount() const {
+        return (count + capacity - 1) / capacity;
+    }
+
+    /**
+     * Rows in a chunk
+     */
+    size_t getChunkSize(size_t chunk) const {
+        return std::min(capacity, count - chunk * capacity);
+    }
+
+    /**
+     * Append a row for entity; its components are left unconstructed
+     * (construct each column with at() before the next row operation)
+     * @return The row
+     */
+    size_t pushRow(Entity::ID entity);
+
+    /**
+     * Destroy a row's components (moved-from ones included) and move the
+     * last row into it
+     * @return Entity moved into row, or INVALID_ENTITY if row was the last
+     */
+    Entity::ID removeRow(size_t row);
+
+    /**
+     * Destroy all rows (chunks are kept)
+     */
+    void clear();
+
+    // ========== Access ==========
+
+    /**
+     * Entity IDs of a chunk's rows
+     */
+    Entity::ID* getEntities(size_t chunk) {
+        return reinterpret_cast<Entity::ID*>(chunks[chunk].get());
+    }
+
+    const Entity::ID* getEntities(size_t chunk) const {
+        return reinterpret_cast<const Entity::ID*>(chunks[chunk].get());
+    }
+
+    Entity::ID getEntity(size_t row) const {
+        return getEntities(row / capacity)[row % capacity];
+    }
+
+    /**
+     * A chunk's values of component T (T must be in the signature)
+     */
+    template<typename T>
+    T* getColumnData(size_t chunk) {
+        return reinterpret_cast<T*>(chunks[chunk].get() + offsets[columnOf[ComponentTypeID<T>::value()]]);
+    }
+
+    template<typename T>
+    const T* getColumnData(size_t chunk) const {
+        return reinterpret_cast<const T*>(chunks[chunk].get() + offsets[columnOf[ComponentTypeID<T>::value()]]);
+    }
+
+    /**
+     * Address of a column's value in a row
+     */
+    void* at(int column, size_t row) {
+        return chunks[row / capacity].get() + offsets[column] + (row % capacity) * infos[column].size;
+    }
+
+    const ComponentInfo& getInfo(int column) const {
+        return infos[column];
+    }
+
+    size_t getColumnCount() const {
+        return infos.size();
+    }
+    
+    /**
+     * Bytes held by this archetype (chunks, including spare ones)
+     */
+    size_t getMemoryUsage() const {
+        return chunks.size() * chunkBytes;
+    }
+
+    /**
+     * Bytes of one column over all chunks (ID column and padding excluded)
+     */
+    size_t getColumnMemoryUsage(int column) const {
+        return chunks.size() * capacity * infos[column].size;
+    }
+
+    // ========== Transitions ==========
+
+    static constexpr uint32_t NO_ARCHETYPE = UINT32_MAX;
+
+    /**
+     * Cached archetype index reached by adding / removing a type
+     * (NO_ARCHETYPE until ArchetypeStorage looks it up)
+     */
+    uint32_t getAddEdge(game::ComponentTypeID typeID) const {
+        return typeID < addEdges.size() ? addEdges[typeID] : NO_ARCHETYPE;
+    }
+
+    uint32_t getRemoveEdge(game::ComponentTypeID typeID) const {
+        return typeID < removeEdges.size() ? removeEdges[typeID] : NO_ARCHETYPE;
+    }
+
+    void setAddEdge(game::ComponentTypeID typeID, uint32_t archetype) {
+        setEdge(addEdges, typeID, archetype);
+    }
+
+    void setRemoveEdge(game::ComponentTypeID typeID, uint32_t archetype) {
+        setEdge(removeEdges, typeID, archetype);
+    }
+
+private:
+    std::vector<ComponentInfo> infos;              // Per column
+    std::vector<game::ComponentTypeID> signature;  // Per column (sorted)
+    std::vector<int> columnOf;                     // ComponentTypeID → column (NO_COLUMN if absent)
+    std::vector<size_t> offsets;                   // Per column, byte offset in a chunk
+    size_t capacity = 0;                           // Rows per chunk
+    size_t chunkBytes = 0;
+
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+    size_t count = 0;
+
+    std::vector<uint32_t> addEdges;     // ComponentTypeID → archetype index
+    std::vector<uint32_t> removeEdges;  // ComponentTypeID → archetype index
+
+    static void setEdge(std::vector<uint32_t>& edges, game::ComponentTypeID typeID, uint32_t archetype) {
+        if (typeID >= edges.size()) {
+            edges.resize(typeID + 1, NO_ARCHETYPE);
+        }
+        edges[typeID] = archetype;
+    }
+
+    /**
+     * Layout for a given row count; returns the bytes a chunk needs
+     */
+    size_t layout(size_t rows);
+};
+
+/**
+ * Archetype Storage
+ *
+ * Alternative to ComponentRegistry (see World's StorageBackend): entities
+ * with the same set of component types share an Archetype, so a query
+ * walks the matching archetypes' chunks linearly instead of doing one
+ * sparse lookup per component per entity.
+ *
+ * Adding or removing a component moves the entity's row to another
+ * archetype (cached per type, so a transition is found in O(1) after
+ * the first time). Pointers to components are invalidated by any add or
+ * remove in the same archetypes, as with ComponentStorage.
+ */
+class ArchetypeStorage {
+public:
+    ArchetypeStorage() = default;
+    ~ArchetypeStorage() = default;
+
+    // Non-copyable
+    ArchetypeStorage(const ArchetypeStorage&) = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+    // Movable
+    ArchetypeStorage(ArchetypeStorage&&) noexcept = default;
+    ArchetypeStorage& operator=(ArchetypeStorage&&) noexcept = default;
+
+    /**
+     * Add component to entity
+     * Returns pointer to the component (the existing one if it has T)
+     */
+    template<typename T, ComponentEnableIf<T> = 0>
+    T* add(Entity::ID entity, const T& component = T{}) {
+        assert(entity != INVALID_ENTITY);
+        const game::ComponentTypeID typeID = ComponentTypeID<T>::value();
+        if (T* existing = get<T>(entity)) {
+            return existing;
+        }
+        registerType(ComponentInfo::of<T>());
+
+        const Location from = locate(entity);
+        const uint32_t to = transition(from.archetype, typeID, true);
+        const size_t row = moveEntity(entity, from, to, typeID);
+
+        Archetype& archetype = *archetypes[to];
+        T* value = static_cast<T*>(archetype.at(archetype.getColumn(typeID), row));
+        new (value) T(component);
+
+        // Leave the old row once the new one is complete (component may
+        // refer to a value there)
+        leave(from);
+        return value;
+    }
+
+    /**
+     * Remove component from entity
+     */
+    template<typename T, ComponentEnableIf<T> = 0>
+    void remove(Entity::ID entity) {
+        const game::ComponentTypeID typeID = ComponentTypeID<T>::value();
+        const Location from = locate(entity);
+        if (from.archetype == Archetype::NO_ARCHETYPE || !archetypes[from.archetype]->has(typeID)) {
+            return;
+        }
+
+        const uint32_t to = transition(from.archetype, typeID, false);
+        if (to == EMPTY_SIGNATURE) {
+            locations[entity] = Location();
+        } else {
+            moveEntity(entity, from, to, typeID);
+        }
+        leave(from);
+    }
+
+    /**
+     * Get component for entity
+     * Returns nullptr if entity doesn't have this component
+     */
+    template<typename T, ComponentEnableIf<T> = 0>
+    T* get(Entity::ID entity) {
+        return static_cast<T*>(find(entity, ComponentTypeID<T>::value()));
+    }
+
+    template<typename T, ComponentEnableIf<T> = 0>
+    const T* get(Entity::ID entity) const {
+        return static_cast<const T*>(const_cast<ArchetypeStorage*>(this)->find(entity, ComponentTypeID<T>::value()));
+    }
+
+    /**
+     * Check if entity has component
+     */
+    template<typename T, ComponentEnableIf<T> = 0>
+    bool has(Entity::ID entity) const {
+        const Location location = locate(entity);
+        return location.archetype != Archetype::NO_ARCHETYPE &&
+               archetypes[location.archetype]->has(ComponentTypeID<T>::value());
+    }
+
+    /**
+     * Remove all components for an entity
+     */
+    void removeAll(Entity::ID entity);
+
+    /**
+     * Destroy all entities' components (archetypes are kept)
+     */
+    void clear();
+
+    /**
+     * Bytes held by all archetypes and the entity locations, and by the
+     * biggest archetype
+     */
+    StorageMemoryUsage getMemoryUsage() const;
+
+    /**
+     * Call fn(typeID, name, bytes) with the memory held by each component
+     * type's columns, summed over archetypes
+     */
+    template<typename Fn>
+    void forEachMemoryUsage(Fn&& fn) const {
+        for (const ComponentInfo& info : infos) {
+            if (info.size == 0) {
+                continue;
+            }
+            size_t bytes = 0;
+            for (const auto& archetype : archetypes) {
+                const int column = archetype->getColumn(info.typeID);
+                if (column != Archetype::NO_COLUMN) {
+                    bytes += archetype->getColumnMemoryUsage(column);
+                }
+            }
+            fn(info.typeID, info.name, bytes);
+        }
+    }
+
+    /**
+     * Archetypes (a query scans these and skips the ones that don't match)
+     */
+    size_t getArchetypeCount() const {
+        return archetypes.size();
+    }
+
+    Archetype& getArchetype(size_t index) {
+        return *archetypes[index];
+    }
+
+    const Archetype& getArchetype(size_t index) const {
+        return *archetypes[index];
+    }
+
+private:
+    struct Location {
+        uint32_t archetype = Archetype::NO_ARCHETYPE;  // NO_ARCHETYPE = no components
+        size_t row = 0;
+    };
+
+    // Transition result for removing an entity's last component
+    static constexpr uint32_t EMPTY_SIGNATURE = Archetype::NO_ARCHETYPE - 1;
+
+    std::vector<std::unique_ptr<Archetype>> archetypes;  // Stable addresses for views
+    std::vector<Location> locations;                     // EntityID → row
+    std::vector<ComponentInfo> infos;                    // ComponentTypeID → type operations (size 0 = unknown)
+
+    Location locate(Entity::ID entity) const {
+        return entity < locations.size() ? locations[entity] : Location();
+    }
+
+    void* find(Entity::ID entity, game::ComponentTypeID typeID);
+    void registerType(const ComponentInfo& info);
+
+    /**
+     * Archetype reached from archetype (NO_ARCHETYPE = no components) by
+     * adding or removing typeID; creates it on first use
+     */
+    uint32_t transition(uint32_t archetype, game::ComponentTypeID typeID, bool add);
+    uint32_t findOrCreate(const std::vector<game::ComponentTypeID>& signature);
+
+    /**
+     * Append a row for entity to archetype to and move the components it
+     * shares with from into it (typeID, the added one, is left for the
+     * caller to construct); records the new location
+     */
+    size_t moveEntity(Entity::ID entity, const Location& from, uint32_t to, game::ComponentTypeID typeID);
+
+    /**
+     * Remove the old row of a moved entity
+     */
+    void leave(const Location& from);
+};
+
+} // namespace game::core
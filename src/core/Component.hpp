@@ -1,10 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <typeinfo>
 #include <type_traits>
 #include "../../include/common/types.hpp"
 #include "Entity.hpp"
 
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
 namespace game::core {
 
 /**
@@ -31,31 +39,84 @@ using ComponentEnableIf = std::enable_if_t<is_component_v<T>, int>;
 /**
  * Component Type ID Generator
  * 
- * Generates unique type IDs for each component type at compile-time.
- * This allows type-safe component access without runtime type information.
+ * Gives each component type a small dense ID (0, 1, 2, ... in order of
+ * first use), so per-type data can live in a flat array indexed by it
+ * (see ComponentRegistry) instead of a type_index hash map.
  * 
- * For network serialization, fixed type IDs are defined in types.hpp
+ * IDs are process-local and depend on use order: for network
+ * serialization, fixed type IDs are defined in types.hpp
  * (ComponentType::Position, ComponentType::Velocity, etc.)
  */
+namespace detail {
+    inline game::ComponentTypeID nextComponentTypeID() {
+        static std::atomic<game::ComponentTypeID> next{0};  // Shared by all component types
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
 template<typename T>
 struct ComponentTypeID {
     static_assert(is_component_v<T>, "T must be a Component");
     
     static ComponentTypeID get() {
-        static ComponentTypeID id = nextID++;
-        return id;
+        return ComponentTypeID(value());
+    }
+    
+    /**
+     * The ID itself (assigned on first call for T)
+     */
+    static game::ComponentTypeID value() {
+        static const game::ComponentTypeID typeID = detail::nextComponentTypeID();
+        return typeID;
     }
     
     operator game::ComponentTypeID() const {
-        return value;
+        return id;
     }
     
-    game::ComponentTypeID value;
+    game::ComponentTypeID id;
     
 private:
-    static inline game::ComponentTypeID nextID = 0;
+    explicit ComponentTypeID(game::ComponentTypeID id) : id(id) {}
 };
 
+namespace detail {
+    /**
+     * Type name without namespaces ("PositionComponent"), demangled on
+     * compilers whose typeid names are mangled
+     */
+    inline std::string readableTypeName(const std::type_info& type) {
+        std::string name = type.name();
+#if defined(__GNUG__)
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+        if (status == 0 && demangled) {
+            name = demangled;
+        }
+        std::free(demangled);
+#endif
+        for (const char* key : {"struct ", "class "}) {  // MSVC
+            if (name.compare(0, std::char_traits<char>::length(key), key) == 0) {
+                name.erase(0, std::char_traits<char>::length(key));
+            }
+        }
+        const size_t scope = name.rfind("::", name.find('<'));  // Template arguments keep theirs
+        if (scope != std::string::npos) {
+            name.erase(0, scope + 2);
+        }
+        return name;
+    }
+}
+
+/**
+ * Readable name of a component type, for diagnostics (memory reports)
+ */
+template<typename T>
+const char* componentName() {
+    static const std::string name = detail::readableTypeName(typeid(T));
+    return name.c_str();
+}
+
 /**
  * Component Tag
  * 
@@ -1,8 +1,8 @@
 #pragma once
 
-#include <unordered_map>
+#include <vector>
 #include <memory>
-#include <typeindex>
+#include <algorithm>
 #include "Entity.hpp"
 #include "Component.hpp"
 #include "ComponentStorage.hpp"
@@ -19,6 +19,8 @@ public:
     virtual void remove(Entity::ID entity) = 0;
     virtual bool has(Entity::ID entity) const = 0;
     virtual size_t size() const = 0;
+    virtual size_t getMemoryUsage() const = 0;
+    virtual const char* getTypeName() const = 0;
     virtual void clear() = 0;
 };
 
@@ -42,6 +44,14 @@ public:
         return storage.size();
     }
     
+    size_t getMemoryUsage() const override {
+        return storage.getMemoryUsage();
+    }
+    
+    const char* getTypeName() const override {
+        return componentName<T>();
+    }
+    
     void clear() override {
         storage.clear();
     }
@@ -65,6 +75,8 @@ private:
  * Provides type-safe access to component storage.
  * 
  * Uses type erasure to store different component types in a single registry.
+ * Storages sit in a flat array indexed by ComponentTypeID<T>, so finding
+ * the storage for T is one indexed load.
  */
 class ComponentRegistry {
 public:
@@ -85,20 +97,20 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     ComponentStorage<T>& getStorage() {
-        auto typeIndex = std::type_index(typeid(T));
-        
-        auto it = storages.find(typeIndex);
-        if (it == storages.end()) {
-            // Create new storage wrapper for this component type
-            auto wrapper = std::make_unique<ComponentStorageWrapper<T>>();
-            ComponentStorageWrapper<T>* wrapperPtr = wrapper.get();
-            storages[typeIndex] = std::move(wrapper);
-            return wrapperPtr->getStorage();
+        if (ComponentStorage<T>* storage = findStorage<T>()) {
+            return *storage;
         }
         
-        // Cast to ComponentStorageWrapper<T> and get storage
-        auto* wrapper = static_cast<ComponentStorageWrapper<T>*>(it->second.get());
-        return wrapper->getStorage();
+        // Create new storage wrapper for this component type
+        const game::ComponentTypeID typeID = ComponentTypeID<T>::value();
+        if (typeID >= storages.size()) {
+            storages.resize(typeID + 1);
+        }
+        auto wrapper = std::make_unique<ComponentStorageWrapper<T>>();
+        ComponentStorageWrapper<T>* wrapperPtr = wrapper.get();
+        storages[typeID] = std::move(wrapper);
+        ++typeCount;
+        return wrapperPtr->getStorage();
     }
     
     /**
@@ -106,18 +118,33 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     const ComponentStorage<T>& getStorage() const {
-        auto typeIndex = std::type_index(typeid(T));
-        
-        auto it = storages.find(typeIndex);
-        if (it == storages.end()) {
-            // Return empty storage (shouldn't happen in practice)
-            static const ComponentStorage<T> empty;
-            return empty;
+        if (const ComponentStorage<T>* storage = findStorage<T>()) {
+            return *storage;
         }
-        
-        // Cast to ComponentStorageWrapper<T> and get storage
-        auto* wrapper = static_cast<const ComponentStorageWrapper<T>*>(it->second.get());
-        return wrapper->getStorage();
+        // Return empty storage (shouldn't happen in practice)
+        static const ComponentStorage<T> empty;
+        return empty;
+    }
+    
+    /**
+     * Storage for component type T, or nullptr if none was created yet
+     */
+    template<typename T, ComponentEnableIf<T> = 0>
+    ComponentStorage<T>* findStorage() {
+        const game::ComponentTypeID typeID = ComponentTypeID<T>::value();
+        if (typeID >= storages.size() || !storages[typeID]) {
+            return nullptr;
+        }
+        return &static_cast<ComponentStorageWrapper<T>*>(storages[typeID].get())->getStorage();
+    }
+    
+    template<typename T, ComponentEnableIf<T> = 0>
+    const ComponentStorage<T>* findStorage() const {
+        const game::ComponentTypeID typeID = ComponentTypeID<T>::value();
+        if (typeID >= storages.size() || !storages[typeID]) {
+            return nullptr;
+        }
+        return &static_cast<const ComponentStorageWrapper<T>*>(storages[typeID].get())->getStorage();
     }
     
     /**
@@ -133,8 +160,8 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     void remove(Entity::ID entity) {
-        if (hasStorage<T>()) {
-            getStorage<T>().remove(entity);
+        if (ComponentStorage<T>* storage = findStorage<T>()) {
+            storage->remove(entity);
         }
     }
     
@@ -143,8 +170,8 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     T* get(Entity::ID entity) {
-        if (!hasStorage<T>()) return nullptr;
-        return getStorage<T>().get(entity);
+        ComponentStorage<T>* storage = findStorage<T>();
+        return storage ? storage->get(entity) : nullptr;
     }
     
     /**
@@ -152,8 +179,8 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     const T* get(Entity::ID entity) const {
-        if (!hasStorage<T>()) return nullptr;
-        return getStorage<T>().get(entity);
+        const ComponentStorage<T>* storage = findStorage<T>();
+        return storage ? storage->get(entity) : nullptr;
     }
     
     /**
@@ -161,8 +188,8 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     bool has(Entity::ID entity) const {
-        if (!hasStorage<T>()) return false;
-        return getStorage<T>().has(entity);
+        const ComponentStorage<T>* storage = findStorage<T>();
+        return storage && storage->has(entity);
     }
     
     /**
@@ -170,16 +197,17 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     bool hasStorage() const {
-        auto typeIndex = std::type_index(typeid(T));
-        return storages.find(typeIndex) != storages.end();
+        return findStorage<T>() != nullptr;
     }
     
     /**
      * Remove all components for an entity
      */
     void removeAll(Entity::ID entity) {
-        for (auto& [typeIndex, storage] : storages) {
-            storage->remove(entity);
+        for (auto& storage : storages) {
+            if (storage) {
+                storage->remove(entity);
+            }
         }
     }
     
@@ -188,21 +216,51 @@ public:
      */
     void clear() {
         storages.clear();
+        typeCount = 0;
+    }
+    
+    /**
+     * Bytes held by all storages, and by the biggest one
+     */
+    StorageMemoryUsage getMemoryUsage() const {
+        StorageMemoryUsage usage;
+        usage.total = storages.capacity() * sizeof(std::unique_ptr<IComponentStorage>);
+        for (const auto& storage : storages) {
+            if (storage) {
+                const size_t bytes = storage->getMemoryUsage();
+                usage.total += bytes;
+                usage.largest = std::max(usage.largest, bytes);
+            }
+        }
+        return usage;
+    }
+    
+    /**
+     * Call fn(typeID, name, bytes) with the memory held by each storage
+     */
+    template<typename Fn>
+    void forEachMemoryUsage(Fn&& fn) const {
+        for (size_t typeID = 0; typeID < storages.size(); ++typeID) {
+            if (storages[typeID]) {
+                fn(static_cast<game::ComponentTypeID>(typeID), storages[typeID]->getTypeName(),
+                   storages[typeID]->getMemoryUsage());
+            }
+        }
     }
     
     /**
      * Get number of component types registered
      */
     size_t getTypeCount() const {
-        return storages.size();
+        return typeCount;
     }
     
 private:
-    // Type-erased storage map
-    // Key: std::type_index (component type)
-    // Value: std::unique_ptr to ComponentStorage<T> (type-erased)
-    std::unordered_map<std::type_index, std::unique_ptr<IComponentStorage>> storages;
+    // Type-erased storages
+    // Index: ComponentTypeID<T> (dense, so the array stays small)
+    // Value: std::unique_ptr to ComponentStorageWrapper<T> (nullptr = no storage yet)
+    std::vector<std::unique_ptr<IComponentStorage>> storages;
+    size_t typeCount = 0;
 };
 
 } // namespace game::core
-
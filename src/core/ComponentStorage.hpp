@@ -1,13 +1,25 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include <cassert>
+#include <cstdint>
+#include <limits>
+#include <iterator>
 #include <algorithm>
 #include "Entity.hpp"
 #include "Component.hpp"
 
 namespace game::core {
 
+/**
+ * Bytes held by component storage (see getMemoryUsage)
+ */
+struct StorageMemoryUsage {
+    size_t total = 0;
+    size_t largest = 0;  // Biggest single storage (or archetype)
+};
+
 /**
  * Component Storage using SparseSet data structure
  * 
@@ -19,7 +31,9 @@ namespace game::core {
  * 
  * Structure:
  * - dense: Array of actual components (contiguous, cache-friendly)
- * - sparse: Array mapping EntityID → dense index
+ * - sparse: EntityID → dense index, in pages of PAGE_SIZE entries that
+ *   are allocated on first use and freed when they empty, so a few high
+ *   entity IDs cost a page each instead of an array up to the highest ID
  * - reverse: Array mapping dense index → EntityID
  */
 template<typename T, ComponentEnableIf<T> = 0>
@@ -51,16 +65,14 @@ public:
             return get(entity);
         }
         
-        // Resize sparse array if needed
-        if (entity >= sparse.size()) {
-            sparse.resize(entity + 1, INVALID_INDEX);
-        }
-        
         // Add component to dense array
-        size_t denseIndex = dense.size();
+        const uint32_t denseIndex = static_cast<uint32_t>(dense.size());
         dense.push_back(component);
         reverse.push_back(entity);
-        sparse[entity] = denseIndex;
+        
+        Page& page = getOrCreatePage(entity);
+        page.indices[entity % PAGE_SIZE] = denseIndex;
+        ++page.used;
         
         return &dense[denseIndex];
     }
@@ -71,21 +83,26 @@ public:
     void remove(EntityID entity) {
         if (!has(entity)) return;
         
-        size_t denseIndex = sparse[entity];
-        size_t lastDenseIndex = dense.size() - 1;
+        const uint32_t denseIndex = sparseIndex(entity);
+        const uint32_t lastDenseIndex = static_cast<uint32_t>(dense.size() - 1);
         
         // Swap with last element (for O(1) removal)
         if (denseIndex != lastDenseIndex) {
             dense[denseIndex] = std::move(dense[lastDenseIndex]);
             EntityID lastEntity = reverse[lastDenseIndex];
             reverse[denseIndex] = lastEntity;
-            sparse[lastEntity] = denseIndex;
+            pages[lastEntity / PAGE_SIZE]->indices[lastEntity % PAGE_SIZE] = denseIndex;
         }
         
         // Remove last element
         dense.pop_back();
         reverse.pop_back();
-        sparse[entity] = INVALID_INDEX;
+        
+        std::unique_ptr<Page>& page = pages[entity / PAGE_SIZE];
+        page->indices[entity % PAGE_SIZE] = INVALID_INDEX;
+        if (--page->used == 0) {
+            page.reset();
+        }
     }
     
     /**
@@ -93,9 +110,7 @@ public:
      * Returns nullptr if entity doesn't have this component
      */
     T* get(EntityID entity) {
-        if (entity >= sparse.size()) return nullptr;
-        
-        size_t denseIndex = sparse[entity];
+        const uint32_t denseIndex = sparseIndex(entity);
         if (denseIndex == INVALID_INDEX) return nullptr;
         
         return &dense[denseIndex];
@@ -105,9 +120,7 @@ public:
      * Get component for entity (const)
      */
     const T* get(EntityID entity) const {
-        if (entity >= sparse.size()) return nullptr;
-        
-        size_t denseIndex = sparse[entity];
+        const uint32_t denseIndex = sparseIndex(entity);
         if (denseIndex == INVALID_INDEX) return nullptr;
         
         return &dense[denseIndex];
@@ -117,8 +130,7 @@ public:
      * Check if entity has this component
      */
     bool has(EntityID entity) const {
-        if (entity >= sparse.size()) return false;
-        return sparse[entity] != INVALID_INDEX;
+        return sparseIndex(entity) != INVALID_INDEX;
     }
     
     /**
@@ -135,13 +147,34 @@ public:
         return dense.empty();
     }
     
+    /**
+     * Entities with this component, in dense (storage) order
+     */
+    const std::vector<EntityID>& getEntities() const {
+        return reverse;
+    }
+    
+    /**
+     * Bytes held by this storage (dense arrays at capacity, page table, pages)
+     */
+    size_t getMemoryUsage() const {
+        size_t pageCount = 0;
+        for (const auto& page : pages) {
+            pageCount += page ? 1 : 0;
+        }
+        return dense.capacity() * sizeof(T) +
+               reverse.capacity() * sizeof(EntityID) +
+               pages.capacity() * sizeof(std::unique_ptr<Page>) +
+               pageCount * sizeof(Page);
+    }
+    
     /**
      * Clear all components
      */
     void clear() {
         dense.clear();
         reverse.clear();
-        sparse.clear();
+        pages.clear();
     }
     
     /**
@@ -228,12 +261,40 @@ public:
         return ConstIterator(this, dense.size());
     }
     
+    static constexpr size_t PAGE_SIZE = 1024;  // Sparse entries per page (4 KB)
+    
 private:
-    static constexpr size_t INVALID_INDEX = std::numeric_limits<size_t>::max();
+    static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
     
-    std::vector<T> dense;              // Actual components (contiguous, cache-friendly)
-    std::vector<size_t> sparse;        // EntityID → dense index mapping
-    std::vector<EntityID> reverse;     // dense index → EntityID mapping
+    struct Page {
+        uint32_t indices[PAGE_SIZE];  // Dense index per entity (INVALID_INDEX = none)
+        uint32_t used = 0;            // Valid indices; the page is freed at 0
+        
+        Page() {
+            std::fill(std::begin(indices), std::end(indices), INVALID_INDEX);
+        }
+    };
+    
+    std::vector<T> dense;                        // Actual components (contiguous, cache-friendly)
+    std::vector<std::unique_ptr<Page>> pages;    // EntityID → dense index mapping (nullptr = empty page)
+    std::vector<EntityID> reverse;               // dense index → EntityID mapping
+    
+    uint32_t sparseIndex(EntityID entity) const {
+        const size_t pageIndex = entity / PAGE_SIZE;
+        if (pageIndex >= pages.size() || !pages[pageIndex]) return INVALID_INDEX;
+        return pages[pageIndex]->indices[entity % PAGE_SIZE];
+    }
+    
+    Page& getOrCreatePage(EntityID entity) {
+        const size_t pageIndex = entity / PAGE_SIZE;
+        if (pageIndex >= pages.size()) {
+            pages.resize(pageIndex + 1);
+        }
+        if (!pages[pageIndex]) {
+            pages[pageIndex] = std::make_unique<Page>();
+        }
+        return *pages[pageIndex];
+    }
 };
 
 } // namespace game::core
@@ -3,7 +3,7 @@
 #include <cstdint>
 #include <limits>
 #include <vector>
-#include <unordered_map>
+#include <functional>
 #include "../../include/common/types.hpp"
 
 namespace game::core {
@@ -17,10 +17,14 @@ namespace game::core {
  * 
  * This prevents issues when an entity is destroyed and its ID is reused,
  * but network packets still reference the old entity.
+ * 
+ * Packed into 64 bits (toHandle: generation high, id low) it can be
+ * written to packets and used as a hash key as is.
  */
 struct Entity {
     using ID = game::EntityID;
     using Generation = uint32_t;
+    using Handle = uint64_t;
     
     ID id;
     Generation generation;
@@ -32,8 +36,16 @@ struct Entity {
         return id != INVALID_ENTITY;
     }
     
+    Handle toHandle() const {
+        return (static_cast<Handle>(generation) << 32) | id;
+    }
+    
+    static Entity fromHandle(Handle handle) {
+        return Entity(static_cast<ID>(handle), static_cast<Generation>(handle >> 32));
+    }
+    
     bool operator==(const Entity& other) const {
-        return id == other.id && generation == other.generation;
+        return toHandle() == other.toHandle();
     }
     
     bool operator!=(const Entity& other) const {
@@ -43,88 +55,105 @@ struct Entity {
     // Hash support for use in containers
     struct Hash {
         std::size_t operator()(const Entity& e) const {
-            return std::hash<ID>{}(e.id) ^ (std::hash<Generation>{}(e.generation) << 1);
+            return std::hash<Handle>{}(e.toHandle());
         }
     };
 };
 
+static_assert(sizeof(game::EntityID) == 4, "Entity handles pack a 32-bit ID");
+
 /**
  * Entity ID Generator
  * 
  * Generates unique entity IDs with generation counters.
- * When an entity is destroyed, its generation is incremented.
- * This allows detection of stale entity references.
+ * When an entity is destroyed, its generation is incremented, so handles
+ * to it stop validating before the ID is reused.
+ * 
+ * versions is dense (indexed by ID): a live ID holds its entity's
+ * generation, so validation is one array load and compare. A free ID
+ * holds the generation its next entity gets, with FREE set so no handle
+ * matches it. Destroyed IDs wait on freeIDs and the most recently
+ * destroyed is reused first (its versions entry is still in cache).
+ * Generations count modulo 2^31; FREE takes the top bit.
  */
 class EntityIDGenerator {
 public:
-    EntityIDGenerator() : nextID(0) {}
+    EntityIDGenerator() = default;
     
     /**
      * Generate a new entity ID
      */
     Entity create() {
+        ++aliveCount;
         if (freeIDs.empty()) {
             // No free IDs, create new one
-            EntityID id = nextID++;
+            const EntityID id = static_cast<EntityID>(versions.size());
+            versions.push_back(0);
             return Entity(id, 0);
-        } else {
-            // Reuse a free ID with incremented generation
-            EntityID id = freeIDs.back();
-            freeIDs.pop_back();
-            Generation gen = generations[id] + 1;
-            generations[id] = gen;
-            return Entity(id, gen);
         }
+        
+        // Reuse a free ID (its generation was incremented on destroy)
+        const EntityID id = freeIDs.back();
+        freeIDs.pop_back();
+        versions[id] &= ~FREE;
+        return Entity(id, versions[id]);
     }
     
     /**
      * Destroy an entity (mark ID as free for reuse)
+     * Ignored for stale or invalid handles
      */
     void destroy(const Entity& entity) {
-        if (!entity.isValid()) return;
+        if (!isValid(entity)) return;
         
-        EntityID id = entity.id;
-        if (id < nextID) {
-            freeIDs.push_back(id);
-            // Generation is already incremented in create()
-        }
+        versions[entity.id] = ((entity.generation + 1) & ~FREE) | FREE;
+        freeIDs.push_back(entity.id);
+        --aliveCount;
     }
     
     /**
      * Check if an entity is valid (not destroyed or reused)
      */
     bool isValid(const Entity& entity) const {
-        if (!entity.isValid()) return false;
-        
-        EntityID id = entity.id;
-        if (id >= nextID) return false;
-        
-        // Check if generation matches
-        auto it = generations.find(id);
-        if (it == generations.end()) {
-            // First generation
-            return entity.generation == 0;
+        return entity.id < versions.size() && (entity.generation & FREE) == 0 &&
+               versions[entity.id] == entity.generation;
+    }
+    
+    /**
+     * Handle of the live entity with this ID (invalid Entity if none)
+     */
+    Entity get(Entity::ID id) const {
+        if (id < versions.size() && (versions[id] & FREE) == 0) {
+            return Entity(id, versions[id]);
         }
-        return entity.generation == it->second;
+        return Entity();
+    }
+    
+    /**
+     * Number of live entities
+     */
+    size_t getAliveCount() const {
+        return aliveCount;
     }
     
     /**
      * Reset generator (for testing/cleanup)
      */
     void reset() {
-        nextID = 0;
+        versions.clear();
         freeIDs.clear();
-        generations.clear();
+        aliveCount = 0;
     }
     
 private:
     using EntityID = Entity::ID;
     using Generation = Entity::Generation;
     
-    EntityID nextID;
-    std::vector<EntityID> freeIDs;  // IDs available for reuse
-    std::unordered_map<EntityID, Generation> generations;  // Current generation for each ID
+    static constexpr Generation FREE = Generation(1) << 31;
+    
+    std::vector<Generation> versions;  // Indexed by ID: live generation, or next generation | FREE
+    std::vector<EntityID> freeIDs;     // Destroyed IDs, most recent last
+    size_t aliveCount = 0;
 };
 
 } // namespace game::core
-
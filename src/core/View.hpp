@@ -0,0 +1,226 @@
+#pragma once
+
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+#include "Entity.hpp"
+#include "ComponentStorage.hpp"
+#include "ArchetypeStorage.hpp"
+
+namespace game::core {
+
+/**
+ * View - Multi-Component Iteration
+ *
+ * Visits every entity that has all of Components, yielding
+ * (entity ID, Components&...) tuples:
+ *
+ *   for (auto [id, pos, vel] : world.view<PositionComponent, VelocityComponent>()) {
+ *       pos.position += vel.velocity * dt;
+ *   }
+ *
+ * On the sparse-set backend iteration is driven by the smallest of the
+ * storages; the others are checked through their sparse arrays. On the
+ * archetype backend it walks the chunks of every archetype that has all
+ * of Components, column by column. Nothing is allocated.
+ *
+ * A const component type (view<const PositionComponent>) yields a const
+ * reference. Don't add or remove components of the viewed types while
+ * iterating (storages move their last element into removed slots):
+ * collect the entities and change them afterwards.
+ */
+template<typename... Components>
+class View {
+    static_assert(sizeof...(Components) > 0, "View needs at least one component type");
+
+    template<typename C>
+    using StorageOf = std::conditional_t<std::is_const_v<C>,
+                                         const ComponentStorage<std::remove_const_t<C>>,
+                                         ComponentStorage<C>>;
+    using Storages = std::tuple<StorageOf<Components>*...>;
+    using Archetypes = std::conditional_t<(std::is_const_v<Components> && ...),
+                                          const ArchetypeStorage, ArchetypeStorage>;
+    using Indices = std::index_sequence_for<Components...>;
+
+public:
+    using value_type = std::tuple<Entity::ID, Components&...>;
+
+    /**
+     * @param storages nullptr for a type nobody has (empty view)
+     */
+    explicit View(StorageOf<Components>*... storages)
+        : storages(storages...) {
+        selectDriver(Indices());
+    }
+    
+    /**
+     * View over an archetype backend (archetypes created while iterating
+     * are not visited)
+     */
+    explicit View(Archetypes* archetypes)
+        : archetypes(archetypes)
+        , archetypeCount(archetypes->getArchetypeCount()) {
+    }
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = View::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        /**
+         * @param archetype Archetype (archetype backend only)
+         * @param index Driver index, or row in archetype
+         */
+        Iterator(const View* view, size_t archetype, size_t index)
+            : view(view), archetype(archetype), index(index) {
+            skipMissing();
+        }
+
+        value_type operator*() const {
+            if (view->archetypes) {
+                return view->archetypeEntry(view->archetypes->getArchetype(archetype), index, Indices());
+            }
+            return view->entry((*view->driver)[index], Indices());
+        }
+
+        Iterator& operator++() {
+            ++index;
+            skipMissing();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return archetype == other.archetype && index == other.index; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        const View* view;
+        size_t archetype;
+        size_t index;
+
+        void skipMissing() {
+            if (view->archetypes) {
+                // Next row of a matching archetype (end is archetypeCount, 0)
+                while (archetype < view->archetypeCount &&
+                       (index >= view->archetypes->getArchetype(archetype).size() ||
+                        !view->matches(view->archetypes->getArchetype(archetype), Indices()))) {
+                    ++archetype;
+                    index = 0;
+                }
+                return;
+            }
+            const size_t end = view->driverSize();
+            while (index < end && !view->hasAll((*view->driver)[index], Indices())) {
+                ++index;
+            }
+        }
+    };
+
+    Iterator begin() const { return Iterator(this, 0, 0); }
+    Iterator end() const {
+        return archetypes ? Iterator(this, archetypeCount, 0) : Iterator(this, 0, driverSize());
+    }
+
+    /**
+     * Call fn(Entity::ID, Components&...) for each entity
+     */
+    template<typename Fn>
+    void each(Fn&& fn) const {
+        if (archetypes) {
+            for (size_t a = 0; a < archetypeCount; ++a) {
+                auto& archetype = archetypes->getArchetype(a);
+                if (matches(archetype, Indices())) {
+                    eachInArchetype(archetype, fn, Indices());
+                }
+            }
+            return;
+        }
+        for (size_t i = 0, end = driverSize(); i < end; ++i) {
+            const Entity::ID entity = (*driver)[i];
+            if (hasAll(entity, Indices())) {
+                std::apply(fn, entry(entity, Indices()));
+            }
+        }
+    }
+
+    /**
+     * Entities the view will look at (upper bound of the entities it yields)
+     */
+    size_t sizeHint() const {
+        if (archetypes) {
+            size_t rows = 0;
+            for (size_t a = 0; a < archetypeCount; ++a) {
+                const Archetype& archetype = archetypes->getArchetype(a);
+                rows += matches(archetype, Indices()) ? archetype.size() : 0;
+            }
+            return rows;
+        }
+        return driverSize();
+    }
+
+    bool empty() const { return begin() == end(); }
+
+private:
+    Storages storages;
+    const std::vector<Entity::ID>* driver = nullptr;  // Entities of the smallest storage
+    Archetypes* archetypes = nullptr;                 // Archetype backend (storages unused)
+    size_t archetypeCount = 0;
+
+    size_t driverSize() const { return driver ? driver->size() : 0; }
+
+    template<size_t... I>
+    void selectDriver(std::index_sequence<I...>) {
+        if (((std::get<I>(storages) == nullptr) || ...)) {
+            return;  // Some type has no storage: nothing matches
+        }
+        size_t smallest = static_cast<size_t>(-1);
+        ((std::get<I>(storages)->size() < smallest
+              ? (smallest = std::get<I>(storages)->size(), driver = &std::get<I>(storages)->getEntities())
+              : driver),
+         ...);
+    }
+
+    template<size_t... I>
+    bool hasAll(Entity::ID entity, std::index_sequence<I...>) const {
+        return (std::get<I>(storages)->has(entity) && ...);
+    }
+
+    template<size_t... I>
+    value_type entry(Entity::ID entity, std::index_sequence<I...>) const {
+        return value_type(entity, *std::get<I>(storages)->get(entity)...);
+    }
+    
+    template<size_t... I>
+    static bool matches(const Archetype& archetype, std::index_sequence<I...>) {
+        return (archetype.has(ComponentTypeID<std::remove_const_t<Components>>::value()) && ...);
+    }
+    
+    template<typename ArchetypeType, size_t... I>
+    static value_type archetypeEntry(ArchetypeType& archetype, size_t row, std::index_sequence<I...>) {
+        const size_t chunk = row / archetype.getChunkCapacity();
+        const size_t index = row % archetype.getChunkCapacity();
+        return value_type(archetype.getEntities(chunk)[index],
+                          archetype.template getColumnData<std::remove_const_t<Components>>(chunk)[index]...);
+    }
+    
+    /**
+     * Linear pass over each chunk's columns
+     */
+    template<typename ArchetypeType, typename Fn, size_t... I>
+    static void eachInArchetype(ArchetypeType& archetype, Fn& fn, std::index_sequence<I...>) {
+        for (size_t chunk = 0, chunks = archetype.getChunkCount(); chunk < chunks; ++chunk) {
+            const Entity::ID* entities = archetype.getEntities(chunk);
+            const std::tuple<Components*...> columns(
+                archetype.template getColumnData<std::remove_const_t<Components>>(chunk)...);
+            for (size_t row = 0, rows = archetype.getChunkSize(chunk); row < rows; ++row) {
+                fn(entities[row], std::get<I>(columns)[row]...);
+            }
+        }
+    }
+};
+
+} // namespace game::core
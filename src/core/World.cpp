@@ -2,7 +2,9 @@
 
 namespace game::core {
 
-World::World() = default;
+World::World(StorageBackend backend)
+    : backend(backend) {
+}
 World::~World() {
     shutdown();
 }
@@ -2,11 +2,14 @@
 
 #include <vector>
 #include <memory>
+#include <cassert>
 #include <tuple>
 #include <type_traits>
 #include "Entity.hpp"
 #include "Component.hpp"
 #include "ComponentRegistry.hpp"
+#include "ArchetypeStorage.hpp"
+#include "View.hpp"
 #include "SystemManager.hpp"
 
 using game::core::ComponentEnableIf;
@@ -14,6 +17,19 @@ using game::core::is_component_v;
 
 namespace game::core {
 
+/**
+ * How a World stores components
+ * - SparseSet: one ComponentStorage per type (ComponentRegistry); cheap
+ *   add/remove, one sparse lookup per component per entity in queries
+ * - Archetype: entities grouped by component set in chunked columns
+ *   (ArchetypeStorage); queries are linear passes, add/remove moves the
+ *   entity's components to another archetype
+ */
+enum class StorageBackend {
+    SparseSet,
+    Archetype
+};
+
 /**
  * World - ECS Container
  * 
@@ -29,10 +45,13 @@ namespace game::core {
  *   world.addComponent<PositionComponent>(player.id, {10.0f, 20.0f});
  *   world.registerSystem<MovementSystem>();
  *   world.update(0.016f); // 60 FPS
+ * 
+ * The component API is the same for both storage backends; getStorage()
+ * and getRegistry() exist only on the sparse-set backend.
  */
 class World {
 public:
-    World();
+    explicit World(StorageBackend backend = StorageBackend::SparseSet);
     ~World();
     
     // Non-copyable
@@ -57,12 +76,17 @@ public:
     /**
      * Destroy an entity
      * Removes all components and marks ID as free for reuse
+     * (stale handles are ignored: they can't destroy a reused ID)
      */
     void destroyEntity(const Entity& entity) {
-        if (!entity.isValid()) return;
+        if (!entityGenerator.isValid(entity)) return;
         
         // Remove all components
-        registry.removeAll(entity.id);
+        if (backend == StorageBackend::Archetype) {
+            archetypes.removeAll(entity.id);
+        } else {
+            registry.removeAll(entity.id);
+        }
         
         // Mark entity ID as free
         entityGenerator.destroy(entity);
@@ -75,6 +99,21 @@ public:
         return entityGenerator.isValid(entity);
     }
     
+    /**
+     * Handle of the live entity with this ID (for IDs from views and
+     * components); an invalid Entity if the ID is free
+     */
+    Entity getEntity(Entity::ID id) const {
+        return entityGenerator.get(id);
+    }
+    
+    /**
+     * Number of live entities
+     */
+    size_t getEntityCount() const {
+        return entityGenerator.getAliveCount();
+    }
+    
     // ========== Component Management ==========
     
     /**
@@ -85,6 +124,9 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     T* addComponent(Entity::ID entity, const T& component = T{}) {
+        if (backend == StorageBackend::Archetype) {
+            return archetypes.add<T>(entity, component);
+        }
         return registry.add<T>(entity, component);
     }
     
@@ -93,7 +135,11 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     void removeComponent(Entity::ID entity) {
-        registry.remove<T>(entity);
+        if (backend == StorageBackend::Archetype) {
+            archetypes.remove<T>(entity);
+        } else {
+            registry.remove<T>(entity);
+        }
     }
     
     /**
@@ -102,6 +148,9 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     T* getComponent(Entity::ID entity) {
+        if (backend == StorageBackend::Archetype) {
+            return archetypes.get<T>(entity);
+        }
         return registry.get<T>(entity);
     }
     
@@ -110,6 +159,9 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     const T* getComponent(Entity::ID entity) const {
+        if (backend == StorageBackend::Archetype) {
+            return archetypes.get<T>(entity);
+        }
         return registry.get<T>(entity);
     }
     
@@ -118,14 +170,19 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     bool hasComponent(Entity::ID entity) const {
+        if (backend == StorageBackend::Archetype) {
+            return archetypes.has<T>(entity);
+        }
         return registry.has<T>(entity);
     }
     
     /**
      * Get component storage (for systems that need direct access)
+     * Sparse-set backend only; prefer view()
      */
     template<typename T, ComponentEnableIf<T> = 0>
     ComponentStorage<T>& getStorage() {
+        assert(backend == StorageBackend::SparseSet);
         return registry.getStorage<T>();
     }
     
@@ -134,6 +191,7 @@ public:
      */
     template<typename T, ComponentEnableIf<T> = 0>
     const ComponentStorage<T>& getStorage() const {
+        assert(backend == StorageBackend::SparseSet);
         return registry.getStorage<T>();
     }
     
@@ -173,35 +231,43 @@ public:
     
     // ========== Query System ==========
     
+    /**
+     * Iterate entities that have all specified components, with references
+     * to the components (see View). Allocates nothing.
+     */
+    template<typename... Components>
+    View<Components...> view() {
+        static_assert((is_component_v<std::remove_const_t<Components>> && ...), "All types must be Components");
+        if (backend == StorageBackend::Archetype) {
+            return View<Components...>(&archetypes);
+        }
+        return View<Components...>(registry.findStorage<std::remove_const_t<Components>>()...);
+    }
+    
+    template<typename... Components>
+    View<const Components...> view() const {
+        static_assert((is_component_v<Components> && ...), "All types must be Components");
+        if (backend == StorageBackend::Archetype) {
+            return View<const Components...>(&archetypes);
+        }
+        return View<const Components...>(registry.findStorage<Components>()...);
+    }
+    
     /**
      * Get all entities that have all specified components
-     * This is a simple implementation - for better performance, use system queries
+     * Allocates the result; prefer view() in per-tick code
      */
     template<typename... Components>
     std::vector<Entity::ID> getEntitiesWith() const {
         static_assert((is_component_v<Components> && ...), "All types must be Components");
         std::vector<Entity::ID> result;
-        
-        // Get all entities from first component type
         if constexpr (sizeof...(Components) > 0) {
-            using FirstComponent = std::tuple_element_t<0, std::tuple<Components...>>;
-            const auto& storage = registry.getStorage<FirstComponent>();
-            
-            for (const auto& pair : storage) {
-                Entity::ID entity = pair.first;
-                
-                // Check if entity has all other components
-                bool hasAll = true;
-                if constexpr (sizeof...(Components) > 1) {
-                    hasAll = hasAllComponentsImpl<Components...>(entity);
-                }
-                
-                if (hasAll) {
-                    result.push_back(entity);
-                }
-            }
+            const View<const Components...> entities = view<Components...>();
+            result.reserve(entities.sizeHint());
+            entities.each([&result](Entity::ID entity, const Components&...) {
+                result.push_back(entity);
+            });
         }
-        
         return result;
     }
     
@@ -221,11 +287,39 @@ public:
      */
     void clear() {
         registry.clear();
+        archetypes.clear();
         entityGenerator.reset();
     }
     
+    StorageBackend getStorageBackend() const {
+        return backend;
+    }
+    
+    /**
+     * Bytes held by component storage (either backend)
+     */
+    StorageMemoryUsage getComponentMemoryUsage() const {
+        if (backend == StorageBackend::Archetype) {
+            return archetypes.getMemoryUsage();
+        }
+        return registry.getMemoryUsage();
+    }
+    
+    /**
+     * Call fn(typeID, name, bytes) for each component type (either backend)
+     */
+    template<typename Fn>
+    void forEachComponentMemoryUsage(Fn&& fn) const {
+        if (backend == StorageBackend::Archetype) {
+            archetypes.forEachMemoryUsage(fn);
+        } else {
+            registry.forEachMemoryUsage(fn);
+        }
+    }
+    
     /**
      * Get component registry (for advanced usage)
+     * Empty on the archetype backend
      */
     ComponentRegistry& getRegistry() {
         return registry;
@@ -236,14 +330,16 @@ public:
     }
     
 private:
+    StorageBackend backend;
     EntityIDGenerator entityGenerator;
-    ComponentRegistry registry;
+    ComponentRegistry registry;      // SparseSet backend
+    ArchetypeStorage archetypes;     // Archetype backend
     SystemManager systemManager;
     
     // Helper for hasAllComponents (fold expression)
     template<typename... Components>
     bool hasAllComponentsImpl(Entity::ID entity) const {
-        return (registry.has<Components>(entity) && ...);
+        return (hasComponent<Components>(entity) && ...);
     }
 };
 
@@ -3,6 +3,7 @@
 #include "../Component.hpp"
 #include "../Entity.hpp"
 #include <SFML/System/Vector2.hpp>
+#include <cstdint>
 
 namespace game::core::components {
 
@@ -17,6 +18,7 @@ struct ProjectileComponent {
     float damage;                 // Damage amount (for future health system)
     float speed;                  // Projectile speed (pixels per second)
     sf::Vector2f direction;      // Normalized direction vector (from owner to target)
+    uint32_t rewindTicks = 0;    // Lag compensation: players are hit where the owner saw them
     
     ProjectileComponent() 
         : ownerID(game::INVALID_ENTITY)
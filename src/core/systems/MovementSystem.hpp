@@ -22,16 +22,9 @@ public:
     ~MovementSystem() override = default;
     
     void update(float deltaTime, World& world) override {
-        auto& positions = world.getStorage<components::PositionComponent>();
-        auto& velocities = world.getStorage<components::VelocityComponent>();
-        
-        for (const auto& pair : velocities) {
-            Entity::ID entityID = pair.first;
-            const auto& velocity = *pair.second;
-            auto* position = positions.get(entityID);
-            if (position) {
-                position->position += velocity.velocity * deltaTime;
-            }
+        for (auto [entityID, position, velocity] :
+             world.view<components::PositionComponent, const components::VelocityComponent>()) {
+            position.position += velocity.velocity * deltaTime;
         }
     }
     
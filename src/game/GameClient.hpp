@@ -5,6 +5,8 @@
 #include <SFML/Graphics.hpp>
 #include "../client/ClientNetworkManager.hpp"
 #include "../network/Packet.hpp"
+#include "SnapshotInterpolation.hpp"
+#include "GameConstants.hpp"
 
 namespace game::client {
 
@@ -16,14 +18,14 @@ namespace game::client {
 class GameClient : public game::client::ClientNetworkManager {
 public:
     void onConnectAck(game::core::Entity::ID entityID) override;
-    void onSnapshot(game::network::Packet& packet) override;
+    void onSnapshot(const game::network::Snapshot& snapshot) override;
     void onDisconnect() override;
     
     game::core::Entity::ID myEntityID = 0;
     
     struct RemoteEntity {
+        uint32_t generation = 0;      // Entity generation (a reused ID is a new entity)
         sf::Vector2f position;        // Current position (from latest snapshot)
-        sf::Vector2f previousPosition; // Previous position (for interpolation)
         sf::Vector2f size;
         sf::Color color;
         float health = 10.0f;      // Current health
@@ -31,14 +33,18 @@ public:
         bool hasHealth = false;   // Whether entity has health component
         int killCount = 0;        // Kill count
         bool hasKillCounter = false;  // Whether entity has kill counter component
-        
-        // Interpolation data
-        float snapshotTime = 0.0f;      // Time when this snapshot was received
-        float previousSnapshotTime = 0.0f;  // Time of previous snapshot
-        bool hasPreviousPosition = false;    // Whether we have previous position for interpolation
     };
     
+    // Latest state, updated in place on each snapshot
     std::map<game::core::Entity::ID, RemoteEntity> remoteEntities;
+    
+    // Delayed playback of remote entity positions, keyed by server tick
+    SnapshotInterpolation interpolation{Constants::INTERPOLATION_DELAY};
+    
+    // Reconciliation: newest input tick the server applied to our entity
+    // in the latest snapshot; set whenever a snapshot arrives
+    uint32_t inputAck = 0;
+    bool hasNewSnapshot = false;
 };
 
 } // namespace game::client
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Color.hpp>
 
@@ -32,12 +33,14 @@ namespace Constants {
     
     // Network settings
     constexpr float HEARTBEAT_INTERVAL = 1.0f;  // seconds
+    constexpr float INTERPOLATION_DELAY = 0.1f;  // seconds behind the server (minimum)
     
     // Shooting/Projectile settings
     constexpr float PROJECTILE_SPEED = 300.0f;  // pixels per second
     const sf::Vector2f PROJECTILE_SIZE = {2.0f, 2.0f};  // width, height
     constexpr float PROJECTILE_LIFETIME = 5.0f;  // seconds
     constexpr float PROJECTILE_SPAWN_OFFSET = 10.0f;  // pixels ahead of player
+    constexpr uint32_t WEAPON_COOLDOWN_TICKS = 6;  // input ticks between shots (matches ServerConfig)
     const sf::Color PROJECTILE_COLOR = sf::Color::Yellow;
 }
 
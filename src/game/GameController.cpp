@@ -1,6 +1,7 @@
 #include "GameController.hpp"
 #include "GameConstants.hpp"
 #include <chrono>
+#include <cmath>
 #include <iostream>
 
 namespace game::client {
@@ -10,6 +11,10 @@ static std::chrono::steady_clock::time_point lastPositionLogTime = std::chrono::
 constexpr float POSITION_LOG_INTERVAL = 5.0f;  // seconds
 
 void GameController::update(GameModel& model, const sf::Window& window) {
+    // Move the render clock of remote entities forward
+    model.networkClient.interpolation.advance(model.deltaTime, model.networkClient.getTimeSync(),
+                                              game::network::TimeSync::localTimeMs());
+    
     // Update player position from server snapshot
     updatePlayerPosition(model);
     
@@ -32,6 +37,12 @@ void GameController::processNetwork(GameModel& model) {
     }
 }
 
+void GameController::flushNetwork(GameModel& model) {
+    if (model.connectedToServer) {
+        model.networkClient.flush();
+    }
+}
+
 void GameController::updatePlayerPosition(GameModel& model) {
     if (!model.connectedToServer) {
         return;
@@ -46,8 +57,16 @@ void GameController::updatePlayerPosition(GameModel& model) {
         return;
     }
     
-    // Interpolate position for smooth movement
-    sf::Vector2f serverPos = interpolateEntityPosition(it->second, model.deltaTime);
+    // Our own entity is predicted locally; the snapshot only corrects it
+    GameClient& client = model.networkClient;
+    if (!model.prediction.isTracking(client.myEntityID)) {
+        model.prediction.reset(client.myEntityID, it->second.position, Constants::PLAYER_SIZE, model.colliders);
+        client.hasNewSnapshot = false;
+    } else if (client.hasNewSnapshot) {
+        model.prediction.reconcile(client.inputAck, it->second.position);
+        client.hasNewSnapshot = false;
+    }
+    sf::Vector2f predictedPos = model.prediction.getPosition();
     
     // Update health from server snapshot
     if (it->second.hasHealth) {
@@ -62,7 +81,7 @@ void GameController::updatePlayerPosition(GameModel& model) {
     }
     
     sf::Vector2f oldPos = model.player.getPosition();
-    model.player.setPosition(serverPos);
+    model.player.setPosition(predictedPos);
     
     bool hasCollision = PlayerCollision::checkCollision(model.player, model.colliders);
     
@@ -76,20 +95,51 @@ void GameController::updatePlayerPosition(GameModel& model) {
             model.hasLastValidPosition = true;
         }
     } else {
-        model.lastValidPosition = serverPos;
+        model.lastValidPosition = predictedPos;
         model.hasLastValidPosition = true;
         model.serverPositionInvalid = false;
     }
 }
 
 void GameController::handleInput(GameModel& model, const sf::Window& window) {
-    // CRITICAL: Only process input if this window has focus
+    float velX = 0.0f, velY = 0.0f;
+    
+    // CRITICAL: Only read the keyboard if this window has focus
     // This prevents all clients from responding to the same keyboard input
-    if (!window.hasFocus()) {
-        return;  // This window is not active, don't process input
+    // (an unfocused window still sends zero input so the server's tick stream has no gaps)
+    if (window.hasFocus()) {
+        readMovementInput(model, velX, velY);
     }
     
-    float velX = 0.0f, velY = 0.0f;
+    // CRITICAL: Only send INPUT if we have a valid entity ID assigned by the server
+    // Each client should ONLY control its own entity, not others
+    // NOTE: Entity ID can be 0 (first client), so we only check for INVALID_ENTITY
+    if (model.connectedToServer && 
+        model.networkClient.isConnected() && 
+        model.networkClient.myEntityID != game::INVALID_ENTITY) {
+        
+        if (model.serverPositionInvalid) {
+            velX = 0.0f;
+            velY = 0.0f;
+        }
+        
+        // One command per fixed tick (the server consumes one per tick),
+        // all of this frame's commands in one packet
+        model.inputAccumulator += model.deltaTime;
+        while (model.inputAccumulator >= Constants::FIXED_DELTA_TIME) {
+            model.prediction.applyInput(model.networkClient.queueInput(sf::Vector2f(velX, velY)));
+            model.inputAccumulator -= Constants::FIXED_DELTA_TIME;
+        }
+        model.networkClient.flushInputs();
+        
+        // Show this frame's input right away instead of on the next frame
+        if (model.prediction.isTracking(model.networkClient.myEntityID) && !model.serverPositionInvalid) {
+            model.player.setPosition(model.prediction.getPosition());
+        }
+    }
+}
+
+void GameController::readMovementInput(GameModel& model, float& velX, float& velY) {
     const float moveSpeed = Constants::PLAYER_MOVE_SPEED;
     
     bool wPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::W);
@@ -145,25 +195,6 @@ void GameController::handleInput(GameModel& model, const sf::Window& window) {
             velY = 0.0f;
         }
     }
-    
-    // CRITICAL: Only send INPUT if we have a valid entity ID assigned by the server
-    // Each client should ONLY control its own entity, not others
-    // NOTE: Entity ID can be 0 (first client), so we only check for INVALID_ENTITY
-    if (model.connectedToServer && 
-        model.networkClient.isConnected() && 
-        !model.serverPositionInvalid &&
-        model.networkClient.myEntityID != game::INVALID_ENTITY) {
-        
-        game::network::Packet inputPacket(game::network::PacketType::INPUT);
-        inputPacket.setSequence(1);
-        inputPacket.setTimestamp(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now().time_since_epoch()
-        ).count()));
-        inputPacket.write(velX);
-        inputPacket.write(velY);
-        
-        model.networkClient.sendPacket(inputPacket);
-    }
 }
 
 bool GameController::wouldCollide(const GameModel& model, float velX, float velY) {
@@ -202,38 +233,30 @@ void GameController::handleShoot(GameModel& model, const sf::RenderWindow& windo
     // Convert to world coordinates using camera
     sf::Vector2f mouseWorld = window.mapPixelToCoords(mousePixel, camera);
     
-    // Send SHOOT packet to server
-    model.networkClient.sendShoot(mouseWorld);
-}
-
-sf::Vector2f GameController::interpolateEntityPosition(const GameClient::RemoteEntity& entity, float deltaTime) {
-    // If no previous position, return current position
-    if (!entity.hasPreviousPosition) {
-        return entity.position;
+    // Weapon cooldown (the server rejects faster shots anyway)
+    const uint32_t inputTick = model.networkClient.getInputTick();
+    if (model.lastShotTick != 0 && inputTick - model.lastShotTick < Constants::WEAPON_COOLDOWN_TICKS) {
+        return;
     }
     
-    // Calculate interpolation alpha based on time since last snapshot
-    // Snapshot rate is 20 Hz (0.05 seconds per snapshot)
-    const float SNAPSHOT_INTERVAL = 0.05f;  // 20 Hz
-    
-    // Time since last snapshot
-    auto now = std::chrono::steady_clock::now();
-    float currentTime = std::chrono::duration<float>(now.time_since_epoch()).count();
-    float timeSinceSnapshot = currentTime - entity.snapshotTime;
-    
-    // Clamp alpha to [0, 1] - if too much time has passed, use current position
-    float alpha = timeSinceSnapshot / SNAPSHOT_INTERVAL;
-    if (alpha >= 1.0f || alpha < 0.0f) {
-        return entity.position;  // Use current position if too much time passed
+    // Send SHOOT packet to server, with the tick we're seeing the others at
+    if (model.networkClient.sendShoot(mouseWorld, estimateViewTick(model.networkClient))) {
+        model.lastShotTick = inputTick;
     }
-    
-    // Linear interpolation between previous and current position
-    sf::Vector2f interpolatedPos;
-    interpolatedPos.x = entity.previousPosition.x + (entity.position.x - entity.previousPosition.x) * alpha;
-    interpolatedPos.y = entity.previousPosition.y + (entity.position.y - entity.previousPosition.y) * alpha;
-    
-    return interpolatedPos;
 }
 
-} // namespace game::client
+sf::Vector2f GameController::interpolateEntityPosition(const GameClient& client, game::core::Entity::ID entityID,
+                                                       const GameClient::RemoteEntity& entity) {
+    // Position at the render tick; latest position until the buffer has it
+    sf::Vector2f position;
+    if (client.interpolation.samplePosition(entityID, position)) {
+        return position;
+    }
+    return entity.position;
+}
 
+uint32_t GameController::estimateViewTick(const GameClient& client) {
+    return client.interpolation.getViewTick();
+}
+
+} // namespace game::client
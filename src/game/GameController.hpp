@@ -27,6 +27,11 @@ public:
      */
     static void processNetwork(GameModel& model);
     
+    /**
+     * Send this frame's outgoing bundle (after update)
+     */
+    static void flushNetwork(GameModel& model);
+    
     /**
      * Handle keyboard input and send to server
      * @param window The render window to check focus state
@@ -34,7 +39,13 @@ public:
     static void handleInput(GameModel& model, const sf::Window& window);
     
     /**
-     * Update player position from server snapshot
+     * Read keyboard movement keys into a velocity (collision-adjusted)
+     */
+    static void readMovementInput(GameModel& model, float& velX, float& velY);
+    
+    /**
+     * Update player position from local prediction, reconciled with
+     * the latest server snapshot
      */
     static void updatePlayerPosition(GameModel& model);
     
@@ -53,10 +64,16 @@ public:
     /**
      * Interpolate entity position for smooth movement
      * @param entity Remote entity with position data
-     * @param deltaTime Time since last frame
-     * @return Interpolated position
+     * @return Position at the render tick (latest position if not buffered)
+     */
+    static sf::Vector2f interpolateEntityPosition(const GameClient& client, game::core::Entity::ID entityID,
+                                                  const GameClient::RemoteEntity& entity);
+    
+    /**
+     * Server tick of the remote entities currently on screen (render tick
+     * of the interpolation buffer)
      */
-    static sf::Vector2f interpolateEntityPosition(const GameClient::RemoteEntity& entity, float deltaTime);
+    static uint32_t estimateViewTick(const GameClient& client);
 };
 
 } // namespace game::client
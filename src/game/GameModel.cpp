@@ -91,6 +91,7 @@ void GameModel::init(const ldtk::Project& ldtk, bool reloading) {
         }
         
         std::cout << "Total colliders loaded: " << colliders.size() << std::endl;
+        prediction.clear();  // Restarts from the next snapshot with the new colliders
         
         // Log all collision positions (once at startup)
         std::cout << "\n=== COLLISION POSITIONS ===" << std::endl;
@@ -5,6 +5,7 @@
 #include <string>
 #include "../TileMap.hpp"
 #include "GameClient.hpp"
+#include "PlayerPrediction.hpp"
 
 namespace game::client {
 
@@ -28,6 +29,7 @@ public:
     std::string serverIp = "127.0.0.1";
     uint16_t serverPort = 7777;
     sf::Vector2f initialPlayerPosition;
+    PlayerPrediction prediction;  // Local player runs ahead of the server
     
     // Camera
     sf::View camera;
@@ -52,8 +54,12 @@ public:
     // Player kill count (from server snapshot)
     int playerKillCount = 0;
     
+    // Input tick of our last shot (0 = none), for the weapon cooldown
+    uint32_t lastShotTick = 0;
+    
     // Frame timing for interpolation
     float deltaTime = 0.016f;  // Default 60 FPS (will be updated each frame)
+    float inputAccumulator = 0.0f;  // Frame time not yet turned into input ticks
     
     /**
      * Initialize game from LDtk project
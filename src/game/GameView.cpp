@@ -43,7 +43,7 @@ void GameView::render(sf::RenderTarget& target, GameModel& model) {
             }
             
             // Interpolate position for smooth rendering
-            sf::Vector2f renderPos = GameController::interpolateEntityPosition(remoteEntity, model.deltaTime);
+            sf::Vector2f renderPos = GameController::interpolateEntityPosition(model.networkClient, entityID, remoteEntity);
             
             // Draw remote entities (players and projectiles)
             // Projectile'lar küçük (2x2), player'lar büyük (3x5) - size'a göre ayırt edilebilir
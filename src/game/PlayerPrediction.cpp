@@ -0,0 +1,107 @@
+#include "PlayerPrediction.hpp"
+#include "GameConstants.hpp"
+#include "../core/systems/MovementSystem.hpp"
+#include "../core/components/PositionComponent.hpp"
+#include "../core/components/VelocityComponent.hpp"
+#include "../core/components/SpriteComponent.hpp"
+#include <cmath>
+#include <memory>
+
+namespace game::client {
+
+PlayerPrediction::PlayerPrediction() {
+    // Same systems, same order as the server's player movement
+    // (CollisionSystem: 50, MovementSystem: 100)
+    auto collision = std::make_unique<game::server::systems::CollisionSystem>(std::vector<sf::FloatRect>());
+    collisionSystem = collision.get();
+    world.registerSystem(std::move(collision));
+    world.registerSystem(std::make_unique<game::core::systems::MovementSystem>());
+    world.initialize();
+}
+
+void PlayerPrediction::reset(game::core::Entity::ID entity, const sf::Vector2f& position, const sf::Vector2f& size,
+                             const std::vector<sf::FloatRect>& colliders) {
+    world.clear();
+    collisionSystem->setColliders(colliders);
+    
+    player = world.createEntity().id;
+    world.addComponent<game::core::components::PositionComponent>(
+        player, game::core::components::PositionComponent(position.x, position.y));
+    world.addComponent<game::core::components::VelocityComponent>(
+        player, game::core::components::VelocityComponent(0.0f, 0.0f));
+    world.addComponent<game::core::components::SpriteComponent>(
+        player, game::core::components::SpriteComponent(size));
+    
+    trackedEntity = entity;
+    active = true;
+    newestTick = 0;
+}
+
+void PlayerPrediction::clear() {
+    world.clear();
+    player = game::INVALID_ENTITY;
+    trackedEntity = game::INVALID_ENTITY;
+    active = false;
+    newestTick = 0;
+}
+
+void PlayerPrediction::applyInput(const game::network::InputCommand& command) {
+    if (!active) {
+        return;
+    }
+    
+    step(command.velocity);
+    
+    Entry& entry = history[command.tick % HISTORY_SIZE];
+    entry.command = command;
+    entry.position = getPosition();
+    newestTick = command.tick;
+}
+
+bool PlayerPrediction::reconcile(uint32_t ackTick, const sf::Vector2f& serverPosition) {
+    if (!active) {
+        return false;
+    }
+    
+    // Commands newer than the ack that are still in the history
+    const bool ackInHistory = ackTick != 0 && ackTick <= newestTick && newestTick - ackTick < HISTORY_SIZE &&
+                              history[ackTick % HISTORY_SIZE].command.tick == ackTick;
+    if (ackInHistory) {
+        const sf::Vector2f predicted = history[ackTick % HISTORY_SIZE].position;
+        if (std::abs(predicted.x - serverPosition.x) <= CORRECTION_THRESHOLD &&
+            std::abs(predicted.y - serverPosition.y) <= CORRECTION_THRESHOLD) {
+            return false;  // Prediction held
+        }
+    } else if (newestTick == 0) {
+        // Nothing predicted yet: follow the server directly
+        world.getComponent<game::core::components::PositionComponent>(player)->position = serverPosition;
+        return false;
+    }
+    
+    // Rewind to the authoritative state and replay what the server hasn't applied yet
+    ++corrections;
+    world.getComponent<game::core::components::PositionComponent>(player)->position = serverPosition;
+    
+    const uint32_t oldestKept = newestTick >= HISTORY_SIZE ? newestTick - HISTORY_SIZE + 1 : 1;
+    for (uint32_t tick = std::max(ackTick + 1, oldestKept); tick <= newestTick; ++tick) {
+        Entry& entry = history[tick % HISTORY_SIZE];
+        if (entry.command.tick != tick) {
+            continue;
+        }
+        step(entry.command.velocity);
+        entry.position = getPosition();
+    }
+    return true;
+}
+
+sf::Vector2f PlayerPrediction::getPosition() const {
+    const auto* position = active ? world.getComponent<game::core::components::PositionComponent>(player) : nullptr;
+    return position ? position->position : sf::Vector2f(0.0f, 0.0f);
+}
+
+void PlayerPrediction::step(const sf::Vector2f& velocity) {
+    world.getComponent<game::core::components::VelocityComponent>(player)->velocity = velocity;
+    world.update(Constants::FIXED_DELTA_TIME);
+}
+
+} // namespace game::client
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "../core/World.hpp"
+#include "../core/Entity.hpp"
+#include "../network/InputCommand.hpp"
+#include "../server/systems/CollisionSystem.hpp"
+
+namespace game::client {
+
+/**
+ * Player Prediction
+ *
+ * Runs the local player through the same movement and collision systems
+ * as the server, one fixed step per input command, so movement shows up
+ * without waiting for the round trip. Every command is kept together
+ * with the position it produced; when a snapshot acknowledges an input
+ * tick whose server position disagrees, the player snaps to the server
+ * position and the newer commands are replayed on top of it.
+ */
+class PlayerPrediction {
+public:
+    static constexpr size_t HISTORY_SIZE = 128;  // ~2 s of commands at 60 Hz
+    static constexpr float CORRECTION_THRESHOLD = 0.1f;  // Pixels
+
+    PlayerPrediction();
+
+    /**
+     * Start predicting an entity from a server position
+     */
+    void reset(game::core::Entity::ID entity, const sf::Vector2f& position, const sf::Vector2f& size,
+               const std::vector<sf::FloatRect>& colliders);
+
+    /**
+     * Stop predicting (disconnect, map reload)
+     */
+    void clear();
+
+    /**
+     * True if predicting this entity
+     */
+    bool isTracking(game::core::Entity::ID entity) const { return active && trackedEntity == entity; }
+
+    /**
+     * Simulate one fixed step with a freshly queued command
+     */
+    void applyInput(const game::network::InputCommand& command);
+
+    /**
+     * Compare against the server's position after the acknowledged tick
+     * and replay newer commands if the prediction was wrong
+     * @return True if a correction was applied
+     */
+    bool reconcile(uint32_t ackTick, const sf::Vector2f& serverPosition);
+
+    /**
+     * Current predicted position
+     */
+    sf::Vector2f getPosition() const;
+
+    /**
+     * Corrections applied so far (diagnostics)
+     */
+    uint64_t getCorrectionCount() const { return corrections; }
+
+private:
+    struct Entry {
+        game::network::InputCommand command;
+        sf::Vector2f position;  // After applying the command
+    };
+
+    game::core::World world;
+    game::server::systems::CollisionSystem* collisionSystem = nullptr;  // Owned by world
+    game::core::Entity::ID player = game::INVALID_ENTITY;
+    game::core::Entity::ID trackedEntity = game::INVALID_ENTITY;
+    bool active = false;
+
+    std::array<Entry, HISTORY_SIZE> history;
+    uint32_t newestTick = 0;  // 0 = no commands applied yet
+    uint64_t corrections = 0;
+
+    void step(const sf::Vector2f& velocity);
+};
+
+} // namespace game::client
@@ -0,0 +1,172 @@
+#include "SnapshotInterpolation.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace game::client {
+
+const SnapshotInterpolation::Sample* SnapshotInterpolation::Frame::find(game::EntityID id) const {
+    auto it = std::lower_bound(samples.begin(), samples.end(), id,
+        [](const Sample& sample, game::EntityID value) { return sample.id < value; });
+    if (it != samples.end() && it->id == id) {
+        return &(*it);
+    }
+    return nullptr;
+}
+
+SnapshotInterpolation::SnapshotInterpolation(float renderDelay)
+    : renderDelay(renderDelay) {
+}
+
+void SnapshotInterpolation::push(const game::network::Snapshot& snapshot, uint32_t arrivalMs) {
+    if (count > 0 && snapshot.tick <= frameAt(0).tick) {
+        return;
+    }
+
+    newest = count == 0 ? 0 : (newest + 1) % BUFFER_SIZE;
+    count = std::min(count + 1, BUFFER_SIZE);
+
+    Frame& frame = frames[newest];
+    frame.tick = snapshot.tick;
+    frame.serverTimeMs = snapshot.serverTime;
+    frame.arrivalMs = arrivalMs;
+    frame.samples.clear();
+    for (const game::network::EntityState& state : snapshot.entities) {
+        frame.samples.push_back(Sample{state.id, state.generation, state.position});  // Already sorted by ID
+    }
+}
+
+void SnapshotInterpolation::advance(float deltaTime, const game::network::TimeSync& timeSync, uint32_t nowMs) {
+    from = nullptr;
+    to = nullptr;
+    if (count == 0) {
+        return;
+    }
+
+    const float period = tickPeriod();
+    const double target = targetTick(timeSync, nowMs);
+    if (!clockStarted || std::abs(target - renderTick) * period > MAX_CLOCK_ERROR) {
+        renderTick = target;
+        clockStarted = true;
+    } else {
+        // Drift toward the target instead of jumping, so motion stays smooth
+        const float error = static_cast<float>(target - renderTick) * period;
+        const float rate = 1.0f + std::clamp(error / CLOCK_CORRECTION_TIME, -CLOCK_ADJUST, CLOCK_ADJUST);
+        renderTick += static_cast<double>(deltaTime * rate / period);
+    }
+
+    const Frame& latest = frameAt(0);
+    if (renderTick >= latest.tick) {
+        // Ahead of the newest snapshot: continue along the last step, bounded
+        from = count >= 2 ? &frameAt(1) : &latest;
+        to = &latest;
+        alpha = 1.0f;
+        extrapolation = std::min(static_cast<float>(renderTick - latest.tick), MAX_EXTRAPOLATION / period);
+        return;
+    }
+
+    extrapolation = 0.0f;
+    for (size_t age = 1; age < count; ++age) {
+        const Frame& older = frameAt(age);
+        if (older.tick <= renderTick) {
+            from = &older;
+            to = &frameAt(age - 1);
+            alpha = static_cast<float>((renderTick - older.tick) / (to->tick - older.tick));
+            return;
+        }
+    }
+
+    // Behind everything buffered: hold the oldest snapshot
+    from = &frameAt(count - 1);
+    to = from;
+    alpha = 0.0f;
+}
+
+bool SnapshotInterpolation::samplePosition(game::EntityID id, sf::Vector2f& out) const {
+    if (to == nullptr) {
+        return false;
+    }
+    const Sample* target = to->find(id);
+    if (target == nullptr) {
+        return false;
+    }
+    const Sample* source = from->find(id);
+    if (source == nullptr || from == to || source->generation != target->generation) {
+        out = target->position;  // Just appeared (or the ID was reused)
+        return true;
+    }
+
+    if (extrapolation > 0.0f) {
+        const float step = extrapolation / static_cast<float>(to->tick - from->tick);
+        out = target->position + (target->position - source->position) * step;
+    } else {
+        out = source->position + (target->position - source->position) * alpha;
+    }
+    return true;
+}
+
+uint32_t SnapshotInterpolation::getViewTick() const {
+    if (count == 0) {
+        return 0;
+    }
+    const uint32_t newestTick = frameAt(0).tick;
+    if (!clockStarted) {
+        return newestTick;
+    }
+    const double oldestTick = frameAt(count - 1).tick;
+    return static_cast<uint32_t>(std::lround(std::clamp(renderTick, oldestTick, static_cast<double>(newestTick))));
+}
+
+void SnapshotInterpolation::clear() {
+    count = 0;
+    newest = 0;
+    renderTick = 0.0;
+    clockStarted = false;
+    from = nullptr;
+    to = nullptr;
+}
+
+float SnapshotInterpolation::tickPeriod() const {
+    if (count < 2) {
+        return DEFAULT_TICK_PERIOD;
+    }
+    // Server timestamps across the whole buffer, so send-time noise averages out
+    const Frame& oldest = frameAt(count - 1);
+    const Frame& latest = frameAt(0);
+    const uint32_t ticks = latest.tick - oldest.tick;
+    const int32_t milliseconds = static_cast<int32_t>(latest.serverTimeMs - oldest.serverTimeMs);
+    if (ticks == 0 || milliseconds <= 0) {
+        return DEFAULT_TICK_PERIOD;
+    }
+    const float period = static_cast<float>(milliseconds) / 1000.0f / static_cast<float>(ticks);
+    return std::clamp(period, 1.0f / 240.0f, 1.0f / 10.0f);
+}
+
+float SnapshotInterpolation::snapshotInterval() const {
+    if (count < 2) {
+        return 0.0f;
+    }
+    const uint32_t ticks = frameAt(0).tick - frameAt(count - 1).tick;
+    return static_cast<float>(ticks) / static_cast<float>(count - 1) * tickPeriod();
+}
+
+double SnapshotInterpolation::targetTick(const game::network::TimeSync& timeSync, uint32_t nowMs) const {
+    const Frame& latest = frameAt(0);
+    const float delay = std::max(renderDelay, MIN_BUFFERED_INTERVALS * snapshotInterval()) +
+                        JITTER_MARGIN * timeSync.getRttVariance();
+
+    // Time since the newest snapshot could have been sent: server clock
+    // minus the one-way delay, or plain arrival time before the clock
+    // offset is known
+    int32_t sinceLatestMs = 0;
+    if (timeSync.hasClockOffset()) {
+        const uint32_t oneWayMs = static_cast<uint32_t>(timeSync.getRtt() * 500.0f);
+        sinceLatestMs = static_cast<int32_t>(timeSync.toRemoteTime(nowMs) - oneWayMs - latest.serverTimeMs);
+    } else {
+        sinceLatestMs = static_cast<int32_t>(nowMs - latest.arrivalMs);
+    }
+
+    const float seconds = static_cast<float>(sinceLatestMs) / 1000.0f - delay;
+    return static_cast<double>(latest.tick) + static_cast<double>(seconds / tickPeriod());
+}
+
+} // namespace game::client
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <SFML/System/Vector2.hpp>
+#include "../network/Snapshot.hpp"
+#include "../network/TimeSync.hpp"
+#include "../../include/common/types.hpp"
+
+namespace game::client {
+
+/**
+ * Snapshot Interpolation
+ *
+ * Ring of recent snapshot positions stamped with their server tick, and a
+ * render clock (in ticks) that plays them back a fixed delay behind the
+ * estimated server time. Remote entities are drawn between the two
+ * snapshots bracketing the render tick, so packet jitter only changes
+ * how full the ring is, not where things are drawn.
+ *
+ * - Server time: from TimeSync's clock offset once known, otherwise from
+ *   the arrival time of the newest snapshot
+ * - Delay: max(renderDelay, MIN_BUFFERED_INTERVALS x snapshot interval)
+ *   plus a jitter margin from the RTT variance
+ * - The render clock runs at wall-clock speed, sped up or slowed down by
+ *   up to CLOCK_ADJUST to converge on the target; it jumps only when the
+ *   error exceeds MAX_CLOCK_ERROR (connect, long stall)
+ * - Past the newest snapshot, entities are extrapolated along their last
+ *   velocity for at most MAX_EXTRAPOLATION, then held
+ */
+class SnapshotInterpolation {
+public:
+    static constexpr size_t BUFFER_SIZE = 32;
+    static constexpr float DEFAULT_TICK_PERIOD = 1.0f / 60.0f;  // Until measured from snapshots
+    static constexpr float MIN_BUFFERED_INTERVALS = 2.0f;
+    static constexpr float JITTER_MARGIN = 2.0f;        // x RTT variance
+    static constexpr float MAX_EXTRAPOLATION = 0.1f;    // Seconds past the newest snapshot
+    static constexpr float MAX_CLOCK_ERROR = 0.25f;     // Seconds; beyond this the clock jumps
+    static constexpr float CLOCK_ADJUST = 0.1f;         // Max playback rate deviation
+    static constexpr float CLOCK_CORRECTION_TIME = 1.0f;  // Seconds to absorb an error at full rate
+
+    explicit SnapshotInterpolation(float renderDelay = 0.1f);
+
+    /**
+     * Minimum delay behind the estimated server time (seconds)
+     */
+    void setRenderDelay(float seconds) { renderDelay = seconds; }
+    float getRenderDelay() const { return renderDelay; }
+
+    /**
+     * Store the positions of a snapshot; older or repeated ticks are ignored
+     * @param arrivalMs Local receive time (TimeSync::localTimeMs())
+     */
+    void push(const game::network::Snapshot& snapshot, uint32_t arrivalMs);
+
+    /**
+     * Advance the render clock by one frame and find the bracketing snapshots
+     */
+    void advance(float deltaTime, const game::network::TimeSync& timeSync, uint32_t nowMs);
+
+    /**
+     * Position of an entity at the render tick
+     * @return False if the entity isn't in the bracketing snapshots
+     */
+    bool samplePosition(game::EntityID id, sf::Vector2f& out) const;
+
+    /**
+     * Server tick currently on screen (for lag compensation); 0 until the
+     * first snapshot
+     */
+    uint32_t getViewTick() const;
+
+    /**
+     * Drop all snapshots and restart the clock (disconnect)
+     */
+    void clear();
+
+private:
+    struct Sample {
+        game::EntityID id;
+        uint32_t generation;
+        sf::Vector2f position;
+    };
+
+    struct Frame {
+        uint32_t tick = 0;
+        uint32_t serverTimeMs = 0;  // Header timestamp (server clock)
+        uint32_t arrivalMs = 0;     // Local clock
+        std::vector<Sample> samples;  // Sorted by ID; capacity reused
+
+        const Sample* find(game::EntityID id) const;
+    };
+
+    float renderDelay;
+    std::array<Frame, BUFFER_SIZE> frames;
+    size_t newest = 0;  // Index of the newest frame
+    size_t count = 0;
+
+    double renderTick = 0.0;
+    bool clockStarted = false;
+
+    // Result of advance(): frames bracketing renderTick
+    const Frame* from = nullptr;
+    const Frame* to = nullptr;
+    float alpha = 0.0f;          // 0..1 between from and to
+    float extrapolation = 0.0f;  // Ticks past the newest frame (from == to)
+
+    const Frame& frameAt(size_t age) const { return frames[(newest + BUFFER_SIZE - age) % BUFFER_SIZE]; }
+    float tickPeriod() const;
+    float snapshotInterval() const;
+    double targetTick(const game::network::TimeSync& timeSync, uint32_t nowMs) const;
+};
+
+} // namespace game::client
@@ -96,13 +96,7 @@ int main() {
             auto elapsed = std::chrono::duration<float>(now - lastHeartbeat).count();
             
             if (elapsed >= heartbeatInterval && model.networkClient.isConnected()) {
-                game::network::Packet heartbeat(game::network::PacketType::HEARTBEAT);
-                heartbeat.setSequence(1);
-                heartbeat.setTimestamp(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
-                    now.time_since_epoch()
-                ).count()));
-                
-                model.networkClient.sendPacket(heartbeat);
+                model.networkClient.sendHeartbeat();
                 lastHeartbeat = now;
             }
         }
@@ -110,6 +104,9 @@ int main() {
         // Update game state (only process input if window has focus)
         GameController::update(model, window);
         
+        // Input, shots, acks and heartbeat go out together
+        GameController::flushNetwork(model);
+        
         // Update camera
         GameView::updateCamera(model);
 
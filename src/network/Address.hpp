@@ -20,6 +20,13 @@ public:
     const sf::IpAddress& getIpAddress() const { return ipAddress; }
     uint16_t getPort() const { return port; }
     
+    /**
+     * IPv4 address and port packed into 48 bits (unique per address)
+     */
+    uint64_t toKey() const {
+        return (static_cast<uint64_t>(ipAddress.toInteger()) << 16) | port;
+    }
+    
     std::string toString() const {
         return ipAddress.toString() + ":" + std::to_string(port);
     }
@@ -35,7 +42,7 @@ public:
     // Hash support for use in containers
     struct Hash {
         std::size_t operator()(const Address& addr) const {
-            return std::hash<std::string>{}(addr.toString());
+            return std::hash<uint64_t>{}(addr.toKey());
         }
     };
     
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace game::network {
+
+/**
+ * Quantization Spec
+ *
+ * Maps a float in [min, max] to an unsigned integer with a fixed
+ * resolution. Values outside the range are clamped.
+ */
+struct QuantizationSpec {
+    float min = 0.0f;
+    float max = 1.0f;
+    float resolution = 1.0f;  // Smallest representable step
+    uint32_t bits = 1;
+
+    QuantizationSpec() = default;
+    QuantizationSpec(float min, float max, float resolution)
+        : min(min), max(max), resolution(resolution) {
+        const double steps = std::ceil(static_cast<double>(max - min) / resolution);
+        bits = 1;
+        while (bits < 32 && static_cast<double>((1ull << bits) - 1) < steps) {
+            ++bits;
+        }
+    }
+
+    uint32_t quantize(float value) const {
+        const float clamped = std::min(std::max(value, min), max);
+        return static_cast<uint32_t>(std::lround((clamped - min) / resolution));
+    }
+
+    float dequantize(uint32_t value) const {
+        return min + static_cast<float>(value) * resolution;
+    }
+
+    /**
+     * Round a value to what the receiver will decode
+     */
+    float round(float value) const {
+        return dequantize(quantize(value));
+    }
+};
+
+/**
+ * Bit Writer
+ *
+ * Packs values into a caller-owned byte buffer using only as many bits
+ * as each value needs. Writes past the end are dropped and flagged.
+ */
+class BitWriter {
+public:
+    BitWriter(uint8_t* data, size_t capacity)
+        : data(data), capacity(capacity) {}
+
+    void writeBits(uint32_t value, uint32_t bits) {
+        if (bits == 0) return;
+        if (overflowed || bitPos + bits > capacity * 8) {
+            overflowed = true;
+            return;
+        }
+        if (bits < 32) {
+            value &= (1u << bits) - 1;
+        }
+        // LSB-first: fill the current byte, then whole bytes
+        while (bits > 0) {
+            const size_t byteIndex = bitPos >> 3;
+            const uint32_t bitOffset = static_cast<uint32_t>(bitPos & 7);
+            const uint32_t room = 8 - bitOffset;
+            const uint32_t take = std::min(room, bits);
+            if (bitOffset == 0) {
+                data[byteIndex] = 0;
+            }
+            data[byteIndex] |= static_cast<uint8_t>((value & ((1u << take) - 1)) << bitOffset);
+            value >>= take;
+            bits -= take;
+            bitPos += take;
+        }
+    }
+
+    void writeBool(bool value) {
+        writeBits(value ? 1u : 0u, 1);
+    }
+
+    /**
+     * Variable-length unsigned integer: 7 bits per group + continuation bit
+     * (values < 128 cost 8 bits)
+     */
+    void writeVarUint(uint32_t value) {
+        do {
+            uint32_t group = value & 0x7F;
+            value >>= 7;
+            writeBits(group | (value != 0 ? 0x80u : 0u), 8);
+        } while (value != 0 && !overflowed);
+    }
+
+    void writeVarInt(int32_t value) {
+        // ZigZag so small negative numbers stay small
+        writeVarUint((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+    }
+
+    void writeQuantized(float value, const QuantizationSpec& spec) {
+        writeBits(spec.quantize(value), spec.bits);
+    }
+
+    void writeFloat(float value) {
+        uint32_t raw;
+        std::memcpy(&raw, &value, sizeof(raw));
+        writeBits(raw, 32);
+    }
+
+    size_t getBitsWritten() const { return bitPos; }
+    size_t getBytesWritten() const { return (bitPos + 7) >> 3; }
+    bool hasOverflowed() const { return overflowed; }
+
+private:
+    uint8_t* data;
+    size_t capacity;
+    size_t bitPos = 0;
+    bool overflowed = false;
+};
+
+/**
+ * Bit Reader
+ *
+ * Mirror of BitWriter. Reads past the end fail and return zero.
+ */
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size)
+        : data(data), size(size) {}
+
+    bool readBits(uint32_t& value, uint32_t bits) {
+        value = 0;
+        if (bits == 0) return true;
+        if (failed || bitPos + bits > size * 8) {
+            failed = true;
+            return false;
+        }
+        uint32_t shift = 0;
+        while (bits > 0) {
+            const size_t byteIndex = bitPos >> 3;
+            const uint32_t bitOffset = static_cast<uint32_t>(bitPos & 7);
+            const uint32_t room = 8 - bitOffset;
+            const uint32_t take = std::min(room, bits);
+            const uint32_t chunk = (static_cast<uint32_t>(data[byteIndex]) >> bitOffset) & ((1u << take) - 1);
+            value |= chunk << shift;
+            shift += take;
+            bits -= take;
+            bitPos += take;
+        }
+        return true;
+    }
+
+    bool readBool(bool& value) {
+        uint32_t bit;
+        if (!readBits(bit, 1)) return false;
+        value = (bit != 0);
+        return true;
+    }
+
+    bool readVarUint(uint32_t& value) {
+        value = 0;
+        for (uint32_t shift = 0; shift < 35; shift += 7) {
+            uint32_t group;
+            if (!readBits(group, 8)) return false;
+            value |= (group & 0x7F) << shift;
+            if ((group & 0x80) == 0) return true;
+        }
+        failed = true;  // More than 5 groups: corrupt
+        return false;
+    }
+
+    bool readVarInt(int32_t& value) {
+        uint32_t raw;
+        if (!readVarUint(raw)) return false;
+        value = static_cast<int32_t>((raw >> 1) ^ (~(raw & 1) + 1));
+        return true;
+    }
+
+    bool readQuantized(float& value, const QuantizationSpec& spec) {
+        uint32_t raw;
+        if (!readBits(raw, spec.bits)) return false;
+        value = spec.dequantize(raw);
+        return true;
+    }
+
+    bool readFloat(float& value) {
+        uint32_t raw;
+        if (!readBits(raw, 32)) return false;
+        std::memcpy(&value, &raw, sizeof(value));
+        return true;
+    }
+
+    size_t getBitsRead() const { return bitPos; }
+    size_t getBytesRead() const { return (bitPos + 7) >> 3; }
+    bool hasFailed() const { return failed; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t bitPos = 0;
+    bool failed = false;
+};
+
+} // namespace game::network
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "Packet.hpp"
+
+namespace game::network {
+
+/**
+ * BUNDLE payload:
+ *   n x { u8 type, u16 size, size payload bytes } (until the end of the datagram)
+ *
+ * Everything the client sends in one frame (input, shots, snapshot acks,
+ * heartbeat, message block) shares one datagram header instead of paying
+ * one header and one server receive each. Entries are packets built with
+ * Packet(type), minus their header.
+ */
+constexpr size_t BUNDLE_ENTRY_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint16_t);
+
+namespace BundleCodec {
+    /**
+     * Bytes a message takes in a bundle
+     */
+    inline size_t entrySize(const Packet& message) {
+        return BUNDLE_ENTRY_HEADER_SIZE + message.getSize() - PacketHeader::SIZE;
+    }
+
+    /**
+     * Append a message (packet built with Packet(type))
+     * @return False if it doesn't fit; the bundle is left unchanged
+     */
+    inline bool append(Packet& bundle, const Packet& message) {
+        if (message.getSize() < PacketHeader::SIZE || bundle.getSize() + entrySize(message) > MAX_PACKET_SIZE) {
+            return false;
+        }
+        const size_t payloadSize = message.getSize() - PacketHeader::SIZE;
+        bundle.write(message.getType());
+        bundle.write(static_cast<uint16_t>(payloadSize));
+        bundle.writeBytes(message.getData() + PacketHeader::SIZE, payloadSize);
+        return true;
+    }
+
+    /**
+     * Call fn(Packet&) for each entry, in order; the entry gets the
+     * bundle's timestamp (sequence and acks stay 0, they were handled
+     * for the bundle) and its read position at the payload
+     * @return False if the payload is malformed (entries before it were delivered)
+     */
+    template<typename Fn>
+    bool read(Packet& bundle, Fn&& fn) {
+        const uint32_t timestamp = bundle.getTimestamp();
+        while (bundle.getReadRemaining() > 0) {
+            PacketType type = PacketType::INVALID;
+            uint16_t size = 0;
+            if (!bundle.read(type) || !bundle.read(size) || bundle.getReadRemaining() < size) {
+                return false;
+            }
+            Packet message(type);
+            message.setTimestamp(timestamp);
+            message.writeBytes(bundle.getReadData(), size);
+            bundle.skip(size);
+            message.resetRead();
+            fn(message);
+        }
+        return true;
+    }
+}
+
+} // namespace game::network
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include "Address.hpp"
+#include "PacketTypes.hpp"
+
+namespace game::network {
+
+/**
+ * Datagram
+ *
+ * Fixed-size raw UDP payload plus peer address, used where packets cross
+ * threads (no heap buffer, so queue slots can be reused as-is).
+ */
+struct Datagram {
+    Address address;
+    std::chrono::steady_clock::time_point receivedAt;  // Inbound only
+    uint16_t size = 0;
+    uint8_t data[MAX_PACKET_SIZE];
+
+    bool assign(const Address& to, const uint8_t* bytes, size_t length) {
+        if (length > MAX_PACKET_SIZE) {
+            return false;
+        }
+        address = to;
+        size = static_cast<uint16_t>(length);
+        std::memcpy(data, bytes, length);
+        return true;
+    }
+};
+
+} // namespace game::network
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/System/Time.hpp>
+#include "Datagram.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace game::network {
+
+/**
+ * Datagram Socket
+ *
+ * Non-blocking UDP socket that moves datagrams in batches. Backends:
+ * - SfmlDatagramSocket: portable, one call per datagram
+ * - BatchedDatagramSocket (Linux): recvmmsg/sendmmsg, up to
+ *   MAX_BATCH datagrams per syscall
+ */
+class DatagramSocket {
+public:
+    static constexpr size_t MAX_BATCH = 64;
+
+    virtual ~DatagramSocket() = default;
+
+    /**
+     * @param reusePort SO_REUSEPORT: several sockets bind the same port and
+     *                  the kernel spreads senders across them (each sender
+     *                  stays on one socket). Linux backend only.
+     */
+    virtual bool bind(uint16_t port, bool reusePort = false) = 0;
+    virtual void close() = 0;
+
+    /**
+     * Receive up to count datagrams into slots (address, size, data)
+     * @return Number received (0 if nothing is pending)
+     */
+    virtual size_t receiveBatch(Datagram* const* slots, size_t count) = 0;
+
+    /**
+     * Send up to count datagrams
+     * @return Number handed to the OS; the rest should be retried later
+     */
+    virtual size_t sendBatch(const Datagram* const* datagrams, size_t count) = 0;
+
+    /**
+     * Send one datagram
+     */
+    virtual bool send(const Address& address, const uint8_t* data, size_t size) = 0;
+
+    /**
+     * Block until data can be read or the timeout expires
+     */
+    virtual bool waitReadable(sf::Time timeout) = 0;
+
+    /**
+     * Syscalls made so far (receive + send), for batching diagnostics
+     */
+    uint64_t getSyscallCount() const { return syscalls; }
+
+    /**
+     * Datagrams dropped for being larger than MAX_PACKET_SIZE (cut by the
+     * kernel; only the Linux backend can tell)
+     */
+    uint64_t getTruncatedCount() const { return truncated; }
+
+protected:
+    uint64_t syscalls = 0;
+    uint64_t truncated = 0;
+};
+
+/**
+ * SFML backend (fallback on every platform)
+ */
+class SfmlDatagramSocket : public DatagramSocket {
+public:
+    bool bind(uint16_t port, bool reusePort) override {
+        if (reusePort) {
+            return false;  // Not exposed by SFML
+        }
+        if (socket.bind(port) != sf::Socket::Status::Done) {
+            return false;
+        }
+        socket.setBlocking(false);
+        selector.clear();
+        selector.add(socket);
+        return true;
+    }
+
+    void close() override {
+        selector.clear();
+        socket.unbind();
+    }
+
+    size_t receiveBatch(Datagram* const* slots, size_t count) override {
+        size_t received = 0;
+        while (received < count) {
+            Datagram& datagram = *slots[received];
+            std::size_t size = 0;
+            sf::IpAddress senderIp;
+            unsigned short senderPort = 0;
+            ++syscalls;
+            if (socket.receive(datagram.data, MAX_PACKET_SIZE, size, senderIp, senderPort) != sf::Socket::Status::Done) {
+                break;
+            }
+            if (size == 0) {
+                continue;
+            }
+            datagram.address = Address(senderIp, senderPort);
+            datagram.size = static_cast<uint16_t>(size);
+            ++received;
+        }
+        return received;
+    }
+
+    size_t sendBatch(const Datagram* const* datagrams, size_t count) override {
+        for (size_t i = 0; i < count; ++i) {
+            send(datagrams[i]->address, datagrams[i]->data, datagrams[i]->size);
+        }
+        return count;
+    }
+
+    bool send(const Address& address, const uint8_t* data, size_t size) override {
+        ++syscalls;
+        return socket.send(data, size, address.getIpAddress(), address.getPort()) == sf::Socket::Status::Done;
+    }
+
+    bool waitReadable(sf::Time timeout) override {
+        return selector.wait(timeout);
+    }
+
+private:
+    sf::UdpSocket socket;
+    sf::SocketSelector selector;
+};
+
+#ifdef __linux__
+/**
+ * Linux backend: recvmmsg/sendmmsg straight into/out of Datagram slots
+ */
+class BatchedDatagramSocket : public DatagramSocket {
+public:
+    ~BatchedDatagramSocket() override {
+        close();
+    }
+
+    bool bind(uint16_t port, bool reusePort) override {
+        close();
+        fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            return false;
+        }
+        const int enable = 1;
+        if (reusePort && ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0) {
+            close();
+            return false;
+        }
+
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+        local.sin_port = htons(port);
+        if (::bind(fd, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() override {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    size_t receiveBatch(Datagram* const* slots, size_t count) override {
+        size_t total = 0;
+        while (total < count) {
+            const size_t batch = std::min(count - total, MAX_BATCH);
+            for (size_t i = 0; i < batch; ++i) {
+                iov[i].iov_base = slots[total + i]->data;
+                iov[i].iov_len = MAX_PACKET_SIZE;
+                headers[i].msg_hdr = msghdr{};
+                headers[i].msg_hdr.msg_name = &peers[i];
+                headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                headers[i].msg_hdr.msg_iov = &iov[i];
+                headers[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            ++syscalls;
+            const int received = ::recvmmsg(fd, headers, static_cast<unsigned int>(batch), 0, nullptr);
+            if (received <= 0) {
+                break;  // EAGAIN: nothing pending (errors are treated the same)
+            }
+
+            // Compact away empty and truncated datagrams while filling addresses
+            size_t kept = 0;
+            for (int i = 0; i < received; ++i) {
+                if (headers[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                    ++truncated;  // Only a prefix arrived: not a packet
+                    continue;
+                }
+                if (headers[i].msg_len == 0) continue;
+                Datagram& datagram = *slots[total + kept];
+                if (&datagram != slots[total + i]) {
+                    std::memcpy(datagram.data, slots[total + i]->data, headers[i].msg_len);
+                }
+                datagram.address = toAddress(peers[i]);
+                datagram.size = static_cast<uint16_t>(headers[i].msg_len);
+                ++kept;
+            }
+            total += kept;
+            if (static_cast<size_t>(received) < batch) {
+                break;  // Socket drained
+            }
+        }
+        return total;
+    }
+
+    size_t sendBatch(const Datagram* const* datagrams, size_t count) override {
+        size_t total = 0;
+        while (total < count) {
+            const size_t batch = std::min(count - total, MAX_BATCH);
+            for (size_t i = 0; i < batch; ++i) {
+                const Datagram& datagram = *datagrams[total + i];
+                peers[i] = toSockaddr(datagram.address);
+                iov[i].iov_base = const_cast<uint8_t*>(datagram.data);
+                iov[i].iov_len = datagram.size;
+                headers[i].msg_hdr = msghdr{};
+                headers[i].msg_hdr.msg_name = &peers[i];
+                headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                headers[i].msg_hdr.msg_iov = &iov[i];
+                headers[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            ++syscalls;
+            const int sent = ::sendmmsg(fd, headers, static_cast<unsigned int>(batch), 0);
+            if (sent < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                    break;  // Send buffer full, retry later
+                }
+                total += 1;  // Skip the datagram the kernel rejected
+                continue;
+            }
+            total += static_cast<size_t>(sent);
+            if (static_cast<size_t>(sent) < batch) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    bool send(const Address& address, const uint8_t* data, size_t size) override {
+        const sockaddr_in peer = toSockaddr(address);
+        ++syscalls;
+        return ::sendto(fd, data, size, 0, reinterpret_cast<const sockaddr*>(&peer), sizeof(peer)) ==
+               static_cast<ssize_t>(size);
+    }
+
+    bool waitReadable(sf::Time timeout) override {
+        pollfd descriptor{fd, POLLIN, 0};
+        const int milliseconds = std::max(0, static_cast<int>((timeout.asMicroseconds() + 999) / 1000));
+        return ::poll(&descriptor, 1, milliseconds) > 0;
+    }
+
+private:
+    int fd = -1;
+
+    // Scratch for one batch (owned by whichever thread uses the socket)
+    mmsghdr headers[MAX_BATCH];
+    iovec iov[MAX_BATCH];
+    sockaddr_in peers[MAX_BATCH];
+
+    static Address toAddress(const sockaddr_in& peer) {
+        return Address(sf::IpAddress(ntohl(peer.sin_addr.s_addr)), ntohs(peer.sin_port));
+    }
+
+    static sockaddr_in toSockaddr(const Address& address) {
+        sockaddr_in peer{};
+        peer.sin_family = AF_INET;
+        peer.sin_addr.s_addr = htonl(address.getIpAddress().toInteger());
+        peer.sin_port = htons(address.getPort());
+        return peer;
+    }
+};
+#endif
+
+/**
+ * Best available backend
+ * @param batched Use recvmmsg/sendmmsg where supported
+ */
+inline std::unique_ptr<DatagramSocket> createDatagramSocket(bool batched = true) {
+#ifdef __linux__
+    if (batched) {
+        return std::make_unique<BatchedDatagramSocket>();
+    }
+#else
+    (void)batched;
+#endif
+    return std::make_unique<SfmlDatagramSocket>();
+}
+
+} // namespace game::network
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include "Packet.hpp"
+#include "PacketTypes.hpp"
+
+namespace game::network {
+
+/**
+ * Fragment Layout
+ *
+ * SNAPSHOT_FRAGMENT payload:
+ *   u32 snapshotId, u8 fragmentIndex, u8 fragmentCount, fragment bytes
+ *
+ * Every fragment except the last carries exactly FRAGMENT_PAYLOAD_SIZE
+ * bytes, so the receiver can place each one without extra offsets.
+ */
+constexpr size_t FRAGMENT_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint8_t) * 2;
+constexpr size_t FRAGMENT_PAYLOAD_SIZE = MAX_PAYLOAD_SIZE - FRAGMENT_HEADER_SIZE;
+constexpr size_t MAX_FRAGMENTS = 32;  // ~44 KB per snapshot
+constexpr size_t MAX_FRAGMENTED_SIZE = FRAGMENT_PAYLOAD_SIZE * MAX_FRAGMENTS;
+
+/**
+ * Fragment Statistics
+ */
+struct FragmentStats {
+    uint64_t fragmentsSent = 0;         // Sender side
+    uint64_t fragmentsReceived = 0;
+    uint64_t fragmentsLost = 0;         // Missing from sets that were dropped
+    uint64_t snapshotsReassembled = 0;
+    uint64_t snapshotsDropped = 0;      // Incomplete sets (timeout or superseded)
+};
+
+/**
+ * Split a payload into SNAPSHOT_FRAGMENT packets
+ * @param send Called with each finished packet
+ * @return Number of fragments produced (0 if the payload is too large)
+ */
+template<typename SendFn>
+size_t sendFragmented(uint32_t snapshotId, const uint8_t* data, size_t size, SendFn&& send) {
+    const size_t count = (size + FRAGMENT_PAYLOAD_SIZE - 1) / FRAGMENT_PAYLOAD_SIZE;
+    if (count == 0 || count > MAX_FRAGMENTS) {
+        return 0;
+    }
+
+    for (size_t index = 0; index < count; ++index) {
+        const size_t offset = index * FRAGMENT_PAYLOAD_SIZE;
+        const size_t chunk = std::min(FRAGMENT_PAYLOAD_SIZE, size - offset);
+
+        Packet packet(PacketType::SNAPSHOT_FRAGMENT);
+        packet.write(snapshotId);
+        packet.write(static_cast<uint8_t>(index));
+        packet.write(static_cast<uint8_t>(count));
+        packet.writeBytes(data + offset, chunk);
+        send(packet);
+    }
+    return count;
+}
+
+/**
+ * Fragment Assembler
+ *
+ * Collects SNAPSHOT_FRAGMENT packets into complete payloads.
+ * A small fixed number of sets can be in flight; a set that does not
+ * complete within the timeout, or that is older than a completed set,
+ * is dropped.
+ */
+class FragmentAssembler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FragmentAssembler(float timeoutSeconds = 0.5f)
+        : timeout(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(timeoutSeconds))) {
+        // One allocation up front; reassembly itself never allocates
+        for (Slot& slot : slots) {
+            slot.buffer.resize(MAX_FRAGMENTED_SIZE);
+        }
+    }
+
+    /**
+     * Add a fragment (packet read position at start of payload)
+     * @return True if this fragment completed its set; see getData()/getSize()
+     */
+    bool addFragment(Packet& packet, Clock::time_point now) {
+        uint32_t snapshotId = 0;
+        uint8_t index = 0, count = 0;
+        if (!packet.read(snapshotId) || !packet.read(index) || !packet.read(count)) {
+            return false;
+        }
+        if (count == 0 || count > MAX_FRAGMENTS || index >= count) {
+            return false;
+        }
+        const size_t chunk = packet.getReadRemaining();
+        if (chunk > FRAGMENT_PAYLOAD_SIZE || (index + 1 < count && chunk != FRAGMENT_PAYLOAD_SIZE)) {
+            return false;  // Malformed fragment
+        }
+        if (snapshotId <= lastCompletedId) {
+            return false;  // Late fragment of a set we already have or skipped
+        }
+
+        ++stats.fragmentsReceived;
+
+        Slot* slot = findOrCreateSlot(snapshotId, count, now);
+        if (!slot || slot->count != count) {
+            return false;
+        }
+
+        const uint32_t bit = 1u << index;
+        if (slot->receivedMask & bit) {
+            return false;  // Duplicate
+        }
+        slot->receivedMask |= bit;
+        ++slot->received;
+        std::memcpy(slot->buffer.data() + index * FRAGMENT_PAYLOAD_SIZE, packet.getReadData(), chunk);
+        if (index + 1 == count) {
+            slot->size = index * FRAGMENT_PAYLOAD_SIZE + chunk;
+        }
+
+        if (slot->received < slot->count) {
+            return false;
+        }
+
+        // Complete: everything older is now useless
+        ++stats.snapshotsReassembled;
+        lastCompletedId = snapshotId;
+        completed = slot;
+        for (Slot& other : slots) {
+            if (other.active && &other != slot && other.snapshotId < snapshotId) {
+                drop(other);
+            }
+        }
+        slot->active = false;
+        return true;
+    }
+
+    /**
+     * Drop sets that have been waiting longer than the timeout
+     */
+    void expire(Clock::time_point now) {
+        for (Slot& slot : slots) {
+            if (slot.active && now - slot.firstArrival > timeout) {
+                drop(slot);
+            }
+        }
+    }
+
+    /**
+     * Payload of the set completed by the last addFragment() call
+     */
+    const uint8_t* getData() const { return completed ? completed->buffer.data() : nullptr; }
+    size_t getSize() const { return completed ? completed->size : 0; }
+    uint32_t getCompletedId() const { return lastCompletedId; }
+
+    const FragmentStats& getStats() const { return stats; }
+
+    void reset() {
+        for (Slot& slot : slots) {
+            slot.active = false;
+        }
+        completed = nullptr;
+        lastCompletedId = 0;
+    }
+
+private:
+    struct Slot {
+        bool active = false;
+        uint32_t snapshotId = 0;
+        uint8_t count = 0;
+        uint8_t received = 0;
+        uint32_t receivedMask = 0;
+        size_t size = 0;
+        Clock::time_point firstArrival;
+        std::vector<uint8_t> buffer;
+    };
+
+    static constexpr size_t SLOT_COUNT = 4;
+
+    std::array<Slot, SLOT_COUNT> slots;
+    Slot* completed = nullptr;
+    uint32_t lastCompletedId = 0;
+    Clock::duration timeout;
+    FragmentStats stats;
+
+    Slot* findOrCreateSlot(uint32_t snapshotId, uint8_t count, Clock::time_point now) {
+        Slot* oldest = nullptr;
+        for (Slot& slot : slots) {
+            if (slot.active && slot.snapshotId == snapshotId) {
+                return &slot;
+            }
+        }
+        for (Slot& slot : slots) {
+            if (!slot.active) {
+                oldest = &slot;
+                break;
+            }
+            if (!oldest || slot.snapshotId < oldest->snapshotId) {
+                oldest = &slot;
+            }
+        }
+        if (oldest->active) {
+            if (oldest->snapshotId > snapshotId) {
+                return nullptr;  // All slots hold newer sets
+            }
+            drop(*oldest);
+        }
+
+        oldest->active = true;
+        oldest->snapshotId = snapshotId;
+        oldest->count = count;
+        oldest->received = 0;
+        oldest->receivedMask = 0;
+        oldest->size = 0;
+        oldest->firstArrival = now;
+        return oldest;
+    }
+
+    void drop(Slot& slot) {
+        stats.fragmentsLost += slot.count - slot.received;
+        ++stats.snapshotsDropped;
+        slot.active = false;
+    }
+};
+
+} // namespace game::network
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <SFML/System/Vector2.hpp>
+#include "Packet.hpp"
+
+namespace game::network {
+
+/**
+ * Input Command
+ *
+ * Player input for one client tick (fixed 60 Hz step).
+ */
+struct InputCommand {
+    uint32_t tick = 0;
+    sf::Vector2f velocity;
+};
+
+constexpr size_t INPUT_REDUNDANCY = 4;       // Commands repeated in every INPUT packet
+constexpr size_t MAX_INPUTS_PER_PACKET = 16;
+
+/**
+ * INPUT payload:
+ *   u32 newestTick, u8 count, count x { f32 velX, f32 velY } (newest first,
+ *   tick of entry i = newestTick - i)
+ *
+ * Each packet repeats the last few commands, so a lost packet is covered
+ * by the next one without sending more often.
+ */
+namespace InputCodec {
+    /**
+     * @param newestFirst Commands with consecutive ticks, newest first
+     */
+    inline void write(Packet& packet, const InputCommand* newestFirst, size_t count) {
+        if (count > MAX_INPUTS_PER_PACKET) {
+            count = MAX_INPUTS_PER_PACKET;
+        }
+        packet.write(count > 0 ? newestFirst[0].tick : 0u);
+        packet.write(static_cast<uint8_t>(count));
+        for (size_t i = 0; i < count; ++i) {
+            packet.write(newestFirst[i].velocity.x);
+            packet.write(newestFirst[i].velocity.y);
+        }
+    }
+
+    /**
+     * Call fn(const InputCommand&) for each command, newest first
+     * @return False if the payload is malformed
+     */
+    template<typename Fn>
+    bool read(Packet& packet, Fn&& fn) {
+        uint32_t newestTick = 0;
+        uint8_t count = 0;
+        if (!packet.read(newestTick) || !packet.read(count) || count > MAX_INPUTS_PER_PACKET) {
+            return false;
+        }
+        for (uint8_t i = 0; i < count && i <= newestTick; ++i) {
+            InputCommand command;
+            command.tick = newestTick - i;
+            if (!packet.read(command.velocity.x) || !packet.read(command.velocity.y)) {
+                return false;
+            }
+            fn(command);
+        }
+        return true;
+    }
+}
+
+} // namespace game::network
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <vector>
 #include <cstdint>
 #include <cstring>
+#include <string>
+#include <algorithm>
 #include "PacketTypes.hpp"
+#include "PacketPool.hpp"
 
 namespace game::network {
 
@@ -11,46 +13,70 @@ namespace game::network {
  * Network Packet
  * 
  * Binary packet serialization/deserialization
+ *
+ * Storage is a pooled MAX_PACKET_SIZE buffer (see PacketPool). Copies
+ * share the buffer; the first write to a shared buffer copies it.
  */
 class Packet {
 public:
-    Packet() : readPos(0) {
-        buffer.reserve(MAX_PACKET_SIZE);
-    }
+    Packet() = default;  // Buffer is taken from the pool on first write
     
-    Packet(PacketType type) : readPos(0) {
-        buffer.reserve(MAX_PACKET_SIZE);
+    Packet(PacketType type) {
         writeHeader(type);
     }
     
     // Write operations
     void writeHeader(PacketType type) {
         writePos = 0;
+        overflowed = false;
         write(type);
         write(static_cast<uint32_t>(0));  // sequence (set later)
         write(static_cast<uint32_t>(0));  // timestamp (set later)
+        write(static_cast<uint32_t>(0));  // ack (set by ReliableEndpoint)
+        write(static_cast<uint32_t>(0));  // ack bits
     }
     
     void setSequence(uint32_t seq) {
-        *reinterpret_cast<uint32_t*>(&buffer[sizeof(PacketType)]) = seq;
+        ensureWritable();
+        std::memcpy(buffer.data() + sizeof(PacketType), &seq, sizeof(seq));
     }
     
     void setTimestamp(uint32_t ts) {
-        *reinterpret_cast<uint32_t*>(&buffer[sizeof(PacketType) + sizeof(uint32_t)]) = ts;
+        ensureWritable();
+        std::memcpy(buffer.data() + sizeof(PacketType) + sizeof(uint32_t), &ts, sizeof(ts));
+    }
+    
+    void setAck(uint32_t ack, uint32_t ackBits) {
+        ensureWritable();
+        std::memcpy(buffer.data() + sizeof(PacketType) + sizeof(uint32_t) * 2, &ack, sizeof(ack));
+        std::memcpy(buffer.data() + sizeof(PacketType) + sizeof(uint32_t) * 3, &ackBits, sizeof(ackBits));
     }
     
     template<typename T>
     void write(const T& value) {
         const size_t size = sizeof(T);
-        if (writePos + size > MAX_PACKET_SIZE) {
-            return;  // Buffer overflow protection
+        if (overflowed || writePos + size > MAX_PACKET_SIZE) {
+            // Buffer overflow protection: once a write is dropped, drop all
+            // following writes too so readers never see a spliced payload
+            overflowed = true;
+            return;
         }
         
-        if (writePos + size > buffer.size()) {
-            buffer.resize(writePos + size);
+        ensureWritable();
+        std::memcpy(buffer.data() + writePos, &value, size);
+        writePos += size;
+    }
+    
+    /**
+     * Append raw bytes (e.g. a bit-packed payload)
+     */
+    void writeBytes(const uint8_t* data, size_t size) {
+        if (overflowed || writePos + size > MAX_PACKET_SIZE) {
+            overflowed = true;
+            return;
         }
-        
-        std::memcpy(&buffer[writePos], &value, size);
+        ensureWritable();
+        std::memcpy(buffer.data() + writePos, data, size);
         writePos += size;
     }
     
@@ -68,34 +94,58 @@ public:
     }
     
     PacketType getType() const {
-        if (buffer.size() < sizeof(PacketType)) {
+        if (writePos < sizeof(PacketType)) {
             return PacketType::INVALID;
         }
-        return *reinterpret_cast<const PacketType*>(&buffer[0]);
+        PacketType type;
+        std::memcpy(&type, buffer.data(), sizeof(type));
+        return type;
     }
     
     uint32_t getSequence() const {
-        if (buffer.size() < sizeof(PacketType) + sizeof(uint32_t)) {
+        if (writePos < sizeof(PacketType) + sizeof(uint32_t)) {
             return 0;
         }
-        return *reinterpret_cast<const uint32_t*>(&buffer[sizeof(PacketType)]);
+        uint32_t seq;
+        std::memcpy(&seq, buffer.data() + sizeof(PacketType), sizeof(seq));
+        return seq;
     }
     
     uint32_t getTimestamp() const {
-        if (buffer.size() < sizeof(PacketType) + sizeof(uint32_t) * 2) {
+        if (writePos < sizeof(PacketType) + sizeof(uint32_t) * 2) {
             return 0;
         }
-        return *reinterpret_cast<const uint32_t*>(&buffer[sizeof(PacketType) + sizeof(uint32_t)]);
+        uint32_t ts;
+        std::memcpy(&ts, buffer.data() + sizeof(PacketType) + sizeof(uint32_t), sizeof(ts));
+        return ts;
+    }
+    
+    uint32_t getAck() const {
+        if (writePos < PacketHeader::SIZE) {
+            return 0;
+        }
+        uint32_t ack;
+        std::memcpy(&ack, buffer.data() + sizeof(PacketType) + sizeof(uint32_t) * 2, sizeof(ack));
+        return ack;
+    }
+    
+    uint32_t getAckBits() const {
+        if (writePos < PacketHeader::SIZE) {
+            return 0;
+        }
+        uint32_t bits;
+        std::memcpy(&bits, buffer.data() + sizeof(PacketType) + sizeof(uint32_t) * 3, sizeof(bits));
+        return bits;
     }
     
     template<typename T>
     bool read(T& value) {
         const size_t size = sizeof(T);
-        if (readPos + size > buffer.size()) {
+        if (readPos + size > writePos) {
             return false;  // Not enough data
         }
         
-        std::memcpy(&value, &buffer[readPos], size);
+        std::memcpy(&value, buffer.data() + readPos, size);
         readPos += size;
         return true;
     }
@@ -118,31 +168,75 @@ public:
         return true;
     }
     
+    /**
+     * Advance the read position (e.g. past bytes consumed via getReadData)
+     */
+    bool skip(size_t bytes) {
+        if (readPos + bytes > writePos) {
+            return false;
+        }
+        readPos += bytes;
+        return true;
+    }
+    
+    /**
+     * Unread part of the packet (for BitReader)
+     */
+    const uint8_t* getReadData() const { return buffer ? buffer.data() + readPos : nullptr; }
+    size_t getReadRemaining() const { return readPos < writePos ? writePos - readPos : 0; }
+    
     // Buffer access
-    const uint8_t* getData() const { return buffer.data(); }
-    uint8_t* getData() { return buffer.data(); }  // Non-const version for receiving
+    const uint8_t* getData() const { return buffer ? buffer.data() : nullptr; }
+    uint8_t* getData() {  // Non-const version for receiving
+        ensureWritable();
+        return buffer.data();
+    }
     size_t getSize() const { return writePos; }
-    size_t getCapacity() const { return buffer.capacity(); }
+    size_t getCapacity() const { return MAX_PACKET_SIZE; }
+    
+    /**
+     * True if a write was dropped because the packet was full
+     */
+    bool hasOverflowed() const { return overflowed; }
     
     /**
      * Set packet data from external buffer (for receiving)
      */
     void setData(const uint8_t* data, size_t size) {
-        buffer.assign(data, data + size);
+        writePos = 0;  // Nothing worth preserving if the buffer is shared
+        ensureWritable();
+        size = std::min(size, MAX_PACKET_SIZE);
+        std::memcpy(buffer.data(), data, size);
         writePos = size;
         readPos = 0;
+        overflowed = false;
     }
     
     void clear() {
-        buffer.clear();
+        buffer.reset();
         writePos = 0;
         readPos = 0;
+        overflowed = false;
     }
     
 private:
-    std::vector<uint8_t> buffer;
+    PacketBufferHandle buffer;
     size_t writePos = 0;
     size_t readPos = 0;
+    bool overflowed = false;
+    
+    /**
+     * Make sure this packet owns an unshared buffer (copy-on-write)
+     */
+    void ensureWritable() {
+        if (!buffer) {
+            buffer = PacketBufferHandle::allocate();
+        } else if (buffer.isShared()) {
+            PacketBufferHandle copy = PacketBufferHandle::allocate();
+            std::memcpy(copy.data(), buffer.data(), writePos);
+            buffer = std::move(copy);
+        }
+    }
 };
 
 } // namespace game::network
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "PacketTypes.hpp"
+
+namespace game::network {
+
+class PacketPool;
+
+/**
+ * Packet Buffer
+ *
+ * Fixed-capacity storage for one datagram, owned by a PacketPool and
+ * shared between Packet copies through a reference count.
+ */
+struct PacketBuffer {
+    uint8_t data[MAX_PACKET_SIZE];
+    uint32_t refCount = 0;
+    PacketPool* owner = nullptr;
+    PacketBuffer* nextFree = nullptr;
+};
+
+/**
+ * Packet Pool
+ *
+ * Free list of PacketBuffers. Grows in chunks when empty, so after
+ * warm-up acquiring and releasing packets never touches the heap
+ * (Stats::heapAllocations stops increasing).
+ *
+ * Not thread-safe: use PacketPool::local(), one pool per thread, and
+ * don't hand Packets across threads (the I/O thread uses Datagrams).
+ */
+class PacketPool {
+public:
+    static constexpr size_t CHUNK_SIZE = 64;  // Buffers per heap allocation
+
+    struct Stats {
+        uint64_t heapAllocations = 0;  // Chunks allocated (steady state: constant)
+        uint64_t acquired = 0;         // Buffers handed out in total
+        uint32_t capacity = 0;         // Buffers owned by the pool
+        uint32_t inUse = 0;
+        uint32_t peakInUse = 0;
+    };
+
+    PacketPool() = default;
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    /**
+     * Pool of the calling thread
+     */
+    static PacketPool& local() {
+        static thread_local PacketPool pool;
+        return pool;
+    }
+
+    /**
+     * Get a buffer with refCount 1
+     */
+    PacketBuffer* acquire() {
+        if (!freeList) {
+            grow();
+        }
+        PacketBuffer* buffer = freeList;
+        freeList = buffer->nextFree;
+        buffer->nextFree = nullptr;
+        buffer->refCount = 1;
+
+        ++stats.acquired;
+        ++stats.inUse;
+        if (stats.inUse > stats.peakInUse) {
+            stats.peakInUse = stats.inUse;
+        }
+        return buffer;
+    }
+
+    /**
+     * Return a buffer whose refCount dropped to zero
+     */
+    void release(PacketBuffer* buffer) {
+        buffer->nextFree = freeList;
+        freeList = buffer;
+        --stats.inUse;
+    }
+
+    /**
+     * Pre-allocate so the first packets don't allocate either
+     */
+    void reserve(size_t count) {
+        while (stats.capacity < count) {
+            grow();
+        }
+    }
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    std::vector<std::unique_ptr<PacketBuffer[]>> chunks;
+    PacketBuffer* freeList = nullptr;
+    Stats stats;
+
+    void grow() {
+        chunks.push_back(std::make_unique<PacketBuffer[]>(CHUNK_SIZE));
+        PacketBuffer* chunk = chunks.back().get();
+        for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+            chunk[i].owner = this;
+            chunk[i].nextFree = (i + 1 < CHUNK_SIZE) ? &chunk[i + 1] : freeList;
+        }
+        freeList = chunk;
+        stats.capacity += CHUNK_SIZE;
+        ++stats.heapAllocations;
+    }
+};
+
+/**
+ * Packet Buffer Handle
+ *
+ * Refcounted reference to a pooled buffer: copying shares the buffer,
+ * the last handle returns it to its pool.
+ */
+class PacketBufferHandle {
+public:
+    PacketBufferHandle() = default;
+    explicit PacketBufferHandle(PacketBuffer* buffer) : buffer(buffer) {}
+
+    PacketBufferHandle(const PacketBufferHandle& other) : buffer(other.buffer) {
+        if (buffer) ++buffer->refCount;
+    }
+
+    PacketBufferHandle(PacketBufferHandle&& other) noexcept : buffer(other.buffer) {
+        other.buffer = nullptr;
+    }
+
+    PacketBufferHandle& operator=(const PacketBufferHandle& other) {
+        if (buffer != other.buffer) {
+            reset();
+            buffer = other.buffer;
+            if (buffer) ++buffer->refCount;
+        }
+        return *this;
+    }
+
+    PacketBufferHandle& operator=(PacketBufferHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            buffer = other.buffer;
+            other.buffer = nullptr;
+        }
+        return *this;
+    }
+
+    ~PacketBufferHandle() {
+        reset();
+    }
+
+    void reset() {
+        if (buffer && --buffer->refCount == 0) {
+            buffer->owner->release(buffer);
+        }
+        buffer = nullptr;
+    }
+
+    /**
+     * Fresh buffer from the calling thread's pool
+     */
+    static PacketBufferHandle allocate() {
+        return PacketBufferHandle(PacketPool::local().acquire());
+    }
+
+    bool isShared() const { return buffer && buffer->refCount > 1; }
+    explicit operator bool() const { return buffer != nullptr; }
+
+    uint8_t* data() { return buffer->data; }
+    const uint8_t* data() const { return buffer->data; }
+
+private:
+    PacketBuffer* buffer = nullptr;
+};
+
+} // namespace game::network
@@ -10,16 +10,30 @@ namespace game::network {
  * Network packet type definitions
  */
 enum class PacketType : uint8_t {
-    CONNECT = 0,        // Client → Server: Bağlantı isteği
-    CONNECT_ACK = 1,    // Server → Client: Bağlantı onayı (entity ID gönderir)
+    CONNECT = 0,        // Client → Server: Bağlantı isteği, cookie ister (MIN_CONNECT_SIZE'a kadar doldurulur)
+    CONNECT_ACK = 1,    // Server → Client: Bağlantı onayı (u64 entity handle gönderir)
     DISCONNECT = 2,     // Client → Server veya Server → Client: Bağlantı kesme
-    HEARTBEAT = 3,      // Client ↔ Server: Bağlantı canlı tutma
+    HEARTBEAT = 3,      // Client ↔ Server: Bağlantı canlı tutma + zaman senkronu (u32 echo, u32 hold ms)
     INPUT = 4,          // Client → Server: Oyuncu input'u
     SNAPSHOT = 5,       // Server → Client: Oyun durumu snapshot'ı
-    SHOOT = 6,          // Client → Server: Shooting input (mouse click)
+    SHOOT = 6,          // Client → Server: Shooting input (f32 x, f32 y, u64 entity handle, u32 view tick, u32 client tick)
+    SNAPSHOT_ACK = 7,   // Client → Server: Son alınan snapshot sequence (delta baseline)
+    SNAPSHOT_FRAGMENT = 8, // Server → Client: MTU'dan büyük snapshot'ın bir parçası
+    MESSAGES = 9,       // Client ↔ Server: Sadece mesaj bloğu (reliable/unreliable kanal mesajları)
+    CHALLENGE = 10,     // Server → Client: Stateless cookie (u32 window, u64 mac)
+    CHALLENGE_RESPONSE = 11, // Client → Server: Cookie geri + bağlantı bilgisi (u32 window, u64 mac, f32 x, f32 y, u8 max snapshot rate)
+    CONNECT_REJECT = 12,     // Server → Client: Bağlantı reddedildi (u8 ConnectRejectReason)
+    BUNDLE = 13,        // Client → Server: Bir frame'in tüm mesajları tek datagramda (bkz. Bundle.hpp)
     INVALID = 255
 };
 
+/**
+ * CONNECT_REJECT sebepleri
+ */
+enum class ConnectRejectReason : uint8_t {
+    SERVER_FULL = 0
+};
+
 /**
  * Packet Header
  * 
@@ -29,8 +43,10 @@ struct PacketHeader {
     PacketType type;
     uint32_t sequenceNumber;  // Packet sequence (reliability için)
     uint32_t timestamp;        // Timestamp (milliseconds)
+    uint32_t ack;              // Karşı taraftan alınan en yeni sequence
+    uint32_t ackBits;          // bit i = (ack - 1 - i) de alındı
     
-    static constexpr size_t SIZE = sizeof(PacketType) + sizeof(uint32_t) * 2;
+    static constexpr size_t SIZE = sizeof(PacketType) + sizeof(uint32_t) * 4;
 };
 
 /**
@@ -39,5 +55,11 @@ struct PacketHeader {
 constexpr size_t MAX_PACKET_SIZE = 1400;  // MTU-safe
 constexpr size_t MAX_PAYLOAD_SIZE = MAX_PACKET_SIZE - PacketHeader::SIZE;
 
+/**
+ * CONNECT en az bu boyutta olmalı: CHALLENGE cevabı isteği aşmaz
+ * (sahte kaynak adresiyle amplification yapılamaz)
+ */
+constexpr size_t MIN_CONNECT_SIZE = 64;
+
 } // namespace game::network
 
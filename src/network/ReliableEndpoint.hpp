@@ -0,0 +1,451 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "Packet.hpp"
+#include "PacketTypes.hpp"
+#include "TimeSync.hpp"
+
+namespace game::network {
+
+/**
+ * Message Channels
+ */
+enum class Channel : uint8_t {
+    RELIABLE_ORDERED = 0,      // Resent until acked, delivered once and in order
+    UNRELIABLE_SEQUENCED = 1,  // Sent once; anything older than the newest delivered is dropped
+};
+
+/**
+ * Message Block
+ *
+ * A message is a packet without the datagram header (type + payload).
+ * Several of them ride in one datagram, after the payload-specific data
+ * of MESSAGES packets (nothing) and before the snapshot of SNAPSHOT
+ * packets:
+ *   u8 count, count x { u8 channel, u16 id, u16 size, u8 type, size - 1 payload bytes }
+ */
+constexpr size_t MESSAGE_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint16_t) * 2;
+constexpr size_t MAX_MESSAGES_PER_PACKET = 16;
+
+/**
+ * Wrap-around compare for 16 bit message IDs
+ */
+inline bool messageIdGreater(uint16_t a, uint16_t b) {
+    return static_cast<int16_t>(static_cast<uint16_t>(a - b)) > 0;
+}
+
+/**
+ * Wrap-around compare for 32 bit packet sequence numbers
+ */
+inline bool sequenceGreater(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) > 0;
+}
+
+/**
+ * Reliable Endpoint
+ *
+ * Per-peer reliability state layered on the unreliable datagram socket:
+ * - Every outgoing packet gets a sequence number plus the newest received
+ *   sequence and a 32 bit field of the ones before it (stampHeader).
+ *   Acks therefore ride on whatever traffic flows anyway.
+ * - Acked packets give RTT samples (kept in the peer's TimeSync); reliable
+ *   messages not acked within srtt + 4 * rttvar are written again.
+ * - writeMessages() packs due messages from both channels into the
+ *   packet being built, readMessages() delivers received ones in order.
+ *
+ * Fixed-size windows; nothing allocates after the first messages.
+ */
+class ReliableEndpoint {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t SENT_WINDOW = 256;     // Packets remembered for acks and RTT
+    static constexpr size_t MESSAGE_WINDOW = 64;   // Reliable messages in flight, per direction
+    static constexpr float MIN_RESEND_TIME = 0.05f;
+    static constexpr float MAX_RESEND_TIME = 1.0f;
+
+    struct Stats {
+        uint64_t packetsSent = 0;
+        uint64_t packetsAcked = 0;
+        uint64_t packetsLost = 0;         // Fell out of the ack window unacked
+        uint64_t reliableSent = 0;        // First transmissions
+        uint64_t reliableResent = 0;
+        uint64_t reliableDelivered = 0;
+        uint64_t unreliableDropped = 0;   // Stale on arrival or never fit
+        uint64_t sendWindowFull = 0;      // send() refused, too much unacked
+
+        Stats& operator+=(const Stats& other) {
+            packetsSent += other.packetsSent;
+            packetsAcked += other.packetsAcked;
+            packetsLost += other.packetsLost;
+            reliableSent += other.reliableSent;
+            reliableResent += other.reliableResent;
+            reliableDelivered += other.reliableDelivered;
+            unreliableDropped += other.unreliableDropped;
+            sendWindowFull += other.sendWindowFull;
+            return *this;
+        }
+    };
+
+    /**
+     * Forget all state (new connection)
+     */
+    void reset() {
+        *this = ReliableEndpoint();
+    }
+
+    /**
+     * Queue a message (packet built with Packet(type), header is not sent)
+     * @return False if the reliable window is full
+     */
+    bool send(Channel channel, const Packet& message) {
+        if (message.getSize() < PacketHeader::SIZE) {
+            return false;
+        }
+        if (channel == Channel::RELIABLE_ORDERED) {
+            if (static_cast<uint16_t>(nextReliableId - oldestUnackedId) >= MESSAGE_WINDOW) {
+                ++stats.sendWindowFull;
+                return false;
+            }
+            OutgoingMessage& slot = reliableOut[nextReliableId % MESSAGE_WINDOW];
+            slot.id = nextReliableId++;
+            slot.message = message;
+            slot.pending = true;
+            slot.everSent = false;
+            return true;
+        }
+        if (unreliableOut.size() >= MESSAGE_WINDOW) {
+            unreliableOut.erase(unreliableOut.begin());  // Oldest is the least useful
+            ++stats.unreliableDropped;
+        }
+        unreliableOut.push_back({nextUnreliableId++, message, true, false, Clock::time_point()});
+        return true;
+    }
+
+    /**
+     * True if writeMessages() would write something now
+     */
+    bool hasDueMessages(Clock::time_point now) const {
+        if (!unreliableOut.empty()) {
+            return true;
+        }
+        for (uint16_t id = oldestUnackedId; id != nextReliableId; ++id) {
+            if (isDue(reliableOut[id % MESSAGE_WINDOW], now)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Append a message block with due messages that fit into the packet
+     * (call stampHeader() for the same packet afterwards)
+     * @param reserve Bytes to leave free for data written after the block
+     */
+    void writeMessages(Packet& packet, Clock::time_point now, size_t reserve = 0) {
+        const size_t used = packet.getSize() + sizeof(uint8_t) + reserve;
+        size_t room = used < MAX_PACKET_SIZE ? MAX_PACKET_SIZE - used : 0;
+        selectedCount = 0;
+
+        for (uint16_t id = oldestUnackedId; id != nextReliableId && selectedCount < MAX_MESSAGES_PER_PACKET; ++id) {
+            OutgoingMessage& slot = reliableOut[id % MESSAGE_WINDOW];
+            if (!isDue(slot, now) || !fits(slot, room)) {
+                continue;
+            }
+            selected[selectedCount++] = &slot;
+            stats.reliableSent += slot.everSent ? 0 : 1;
+            stats.reliableResent += slot.everSent ? 1 : 0;
+            slot.everSent = true;
+            slot.lastSent = now;
+        }
+        const size_t reliableCount = selectedCount;
+        for (OutgoingMessage& message : unreliableOut) {
+            if (selectedCount >= MAX_MESSAGES_PER_PACKET) {
+                break;
+            }
+            if (fits(message, room)) {
+                selected[selectedCount++] = &message;
+            }
+        }
+
+        packet.write(static_cast<uint8_t>(selectedCount));
+        for (size_t i = 0; i < selectedCount; ++i) {
+            const OutgoingMessage& message = *selected[i];
+            const size_t payloadSize = message.message.getSize() - PacketHeader::SIZE;
+            packet.write(static_cast<uint8_t>(i < reliableCount ? Channel::RELIABLE_ORDERED : Channel::UNRELIABLE_SEQUENCED));
+            packet.write(message.id);
+            packet.write(static_cast<uint16_t>(payloadSize + 1));
+            packet.write(message.message.getType());
+            packet.writeBytes(message.message.getData() + PacketHeader::SIZE, payloadSize);
+        }
+
+        // Remember reliable IDs for the ack of this packet
+        for (size_t i = 0; i < reliableCount; ++i) {
+            selectedIds[i] = selected[i]->id;
+        }
+        
+        // Unreliable messages go out once; the ones that didn't fit wait for the next packet
+        for (size_t i = reliableCount; i < selectedCount; ++i) {
+            selected[i]->pending = false;
+        }
+        unreliableOut.erase(std::remove_if(unreliableOut.begin(), unreliableOut.end(),
+                                           [](const OutgoingMessage& message) { return !message.pending; }),
+                            unreliableOut.end());
+        selectedCount = reliableCount;
+    }
+
+    /**
+     * Give the packet its sequence number, timestamp and our acks, and remember it
+     */
+    void stampHeader(Packet& packet, Clock::time_point now) {
+        const uint32_t sequence = localSequence++;
+        if (localSequence == 0) {
+            localSequence = 1;  // 0 = not stamped, skipped on wrap
+        }
+        packet.setSequence(sequence);
+        packet.setTimestamp(TimeSync::localTimeMs());
+        packet.setAck(remoteSequence, receivedBits);
+
+        SentPacket& record = sent[sequence % SENT_WINDOW];
+        record.sequence = sequence;
+        record.sentAt = now;
+        record.acked = false;
+        record.messageCount = static_cast<uint8_t>(selectedCount);
+        std::copy(selectedIds.begin(), selectedIds.begin() + selectedCount, record.messageIds.begin());
+        selectedCount = 0;
+        ++stats.packetsSent;
+    }
+
+    /**
+     * Process the header of a packet from the peer (acks + receive window)
+     */
+    void onPacketReceived(const Packet& packet, Clock::time_point now) {
+        const uint32_t sequence = packet.getSequence();
+        if (sequence != 0) {
+            if (remoteSequence == 0 || sequenceGreater(sequence, remoteSequence)) {
+                const uint32_t shift = sequence - remoteSequence;
+                receivedBits = shift >= 32 ? 0 : receivedBits << shift;
+                if (remoteSequence != 0 && shift <= 32) {
+                    receivedBits |= 1u << (shift - 1);
+                }
+                remoteSequence = sequence;
+            } else if (sequenceGreater(remoteSequence, sequence) && remoteSequence - sequence <= 32) {
+                receivedBits |= 1u << (remoteSequence - sequence - 1);
+            }
+        }
+
+        const uint32_t ack = packet.getAck();
+        if (ack == 0) {
+            return;
+        }
+        const uint32_t bits = packet.getAckBits();
+        acknowledge(ack, now);
+        for (uint32_t i = 0; i < 32; ++i) {
+            const uint32_t acked = ack - 1 - i;
+            if ((bits & (1u << i)) && acked != 0) {
+                acknowledge(acked, now);
+            }
+        }
+
+        // Packets more than 32 behind the newest ack can't be acked anymore
+        const uint32_t settled = ack - 32;
+        if (sequenceGreater(settled + 1, lossCursor)) {
+            if (settled - lossCursor >= SENT_WINDOW) {
+                lossCursor = settled - SENT_WINDOW + 1;  // Older ones are no longer remembered
+            }
+            for (; lossCursor != settled + 1; ++lossCursor) {
+                const SentPacket& record = sent[lossCursor % SENT_WINDOW];
+                if (lossCursor != 0 && record.sequence == lossCursor && !record.acked) {
+                    ++stats.packetsLost;
+                }
+            }
+        }
+    }
+
+    /**
+     * Read a message block (packet read position at the block) and
+     * deliver messages: reliable ones once and in order, unreliable ones
+     * only if newer than the last delivered
+     * @param deliver Called with each message as a packet, read position at
+     *                its payload; returns false to stop (e.g. the message
+     *                closed the connection and reset this endpoint), after
+     *                which the endpoint is not touched again
+     * @return False if the block is malformed
+     */
+    template<typename DeliverFn>
+    bool readMessages(Packet& packet, DeliverFn&& deliver) {
+        uint8_t count = 0;
+        if (!packet.read(count)) {
+            return false;
+        }
+        for (uint8_t i = 0; i < count; ++i) {
+            uint8_t channel = 0;
+            uint16_t id = 0, size = 0;
+            PacketType type = PacketType::INVALID;
+            if (!packet.read(channel) || !packet.read(id) || !packet.read(size) || size == 0 ||
+                !packet.read(type) || packet.getReadRemaining() < static_cast<size_t>(size - 1)) {
+                return false;
+            }
+            Packet message(type);
+            message.writeBytes(packet.getReadData(), size - 1);
+            packet.skip(size - 1);
+            message.resetRead();
+
+            if (channel == static_cast<uint8_t>(Channel::UNRELIABLE_SEQUENCED)) {
+                if (hasUnreliableIn && !messageIdGreater(id, lastUnreliableIn)) {
+                    ++stats.unreliableDropped;
+                    continue;
+                }
+                hasUnreliableIn = true;
+                lastUnreliableIn = id;
+                if (!deliver(message)) {
+                    return true;
+                }
+                continue;
+            }
+            if (channel != static_cast<uint8_t>(Channel::RELIABLE_ORDERED)) {
+                return false;
+            }
+
+            const uint16_t distance = static_cast<uint16_t>(id - nextReliableIn);
+            if (distance >= MESSAGE_WINDOW) {
+                continue;  // Already delivered (resend of an acked message) or out of window
+            }
+            IncomingMessage& slot = reliableIn[id % MESSAGE_WINDOW];
+            if (!slot.valid) {
+                slot.valid = true;
+                slot.message = std::move(message);
+            }
+            while (reliableIn[nextReliableIn % MESSAGE_WINDOW].valid) {
+                IncomingMessage& next = reliableIn[nextReliableIn % MESSAGE_WINDOW];
+                next.valid = false;
+                ++nextReliableIn;
+                ++stats.reliableDelivered;
+                // Out of the window first: deliver may reset the endpoint
+                Packet delivered = std::move(next.message);
+                next.message.clear();
+                if (!deliver(delivered)) {
+                    return true;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Latency and clock estimate for this peer
+     */
+    const TimeSync& getTimeSync() const { return timeSync; }
+    TimeSync& getTimeSync() { return timeSync; }
+
+    /**
+     * Seconds before an unacked reliable message is written again
+     */
+    float getResendTimeout() const {
+        const float timeout = timeSync.getRtt() + 4.0f * timeSync.getRttVariance();
+        return std::min(std::max(timeout, MIN_RESEND_TIME), MAX_RESEND_TIME);
+    }
+
+    /**
+     * Reliable messages queued or in flight
+     */
+    size_t getUnackedCount() const { return static_cast<uint16_t>(nextReliableId - oldestUnackedId); }
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct OutgoingMessage {
+        uint16_t id = 0;
+        Packet message;
+        bool pending = false;   // Reliable: not acked yet
+        bool everSent = false;
+        Clock::time_point lastSent;
+    };
+
+    struct IncomingMessage {
+        bool valid = false;
+        Packet message;
+    };
+
+    struct SentPacket {
+        uint32_t sequence = 0;
+        Clock::time_point sentAt;
+        bool acked = true;
+        uint8_t messageCount = 0;
+        std::array<uint16_t, MAX_MESSAGES_PER_PACKET> messageIds{};
+    };
+
+    // Packet level
+    uint32_t localSequence = 1;   // 0 = not stamped
+    uint32_t remoteSequence = 0;  // Newest received
+    uint32_t receivedBits = 0;
+    uint32_t lossCursor = 1;      // Oldest sequence not yet judged lost or acked
+    std::array<SentPacket, SENT_WINDOW> sent;
+    TimeSync timeSync;
+
+    // Outgoing messages
+    std::array<OutgoingMessage, MESSAGE_WINDOW> reliableOut;
+    uint16_t nextReliableId = 0;
+    uint16_t oldestUnackedId = 0;
+    std::vector<OutgoingMessage> unreliableOut;
+    uint16_t nextUnreliableId = 0;
+
+    // Messages written into the packet being built (reliable IDs until stampHeader)
+    std::array<OutgoingMessage*, MAX_MESSAGES_PER_PACKET> selected{};
+    std::array<uint16_t, MAX_MESSAGES_PER_PACKET> selectedIds{};
+    size_t selectedCount = 0;
+
+    // Incoming messages
+    std::array<IncomingMessage, MESSAGE_WINDOW> reliableIn;
+    uint16_t nextReliableIn = 0;
+    uint16_t lastUnreliableIn = 0;
+    bool hasUnreliableIn = false;
+
+    Stats stats;
+
+    bool isDue(const OutgoingMessage& slot, Clock::time_point now) const {
+        if (!slot.pending) {
+            return false;
+        }
+        return !slot.everSent ||
+               std::chrono::duration<float>(now - slot.lastSent).count() >= getResendTimeout();
+    }
+
+    static bool fits(const OutgoingMessage& message, size_t& room) {
+        const size_t size = MESSAGE_HEADER_SIZE + message.message.getSize() - PacketHeader::SIZE + 1;
+        if (size > room) {
+            return false;
+        }
+        room -= size;
+        return true;
+    }
+
+    void acknowledge(uint32_t sequence, Clock::time_point now) {
+        SentPacket& record = sent[sequence % SENT_WINDOW];
+        if (record.sequence != sequence || record.acked) {
+            return;
+        }
+        record.acked = true;
+        ++stats.packetsAcked;
+
+        timeSync.addRttSample(std::chrono::duration<float>(now - record.sentAt).count());
+
+        for (uint8_t i = 0; i < record.messageCount; ++i) {
+            OutgoingMessage& slot = reliableOut[record.messageIds[i] % MESSAGE_WINDOW];
+            if (slot.id == record.messageIds[i] && slot.pending) {
+                slot.pending = false;
+                slot.message.clear();
+            }
+        }
+        while (oldestUnackedId != nextReliableId && !reliableOut[oldestUnackedId % MESSAGE_WINDOW].pending) {
+            ++oldestUnackedId;
+        }
+    }
+};
+
+} // namespace game::network
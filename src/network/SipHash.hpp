@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace game::network {
+
+/**
+ * SipHash-2-4
+ *
+ * Keyed 64 bit hash (a MAC for short inputs): without the 128 bit key an
+ * attacker can't produce a value that verifies. Used for stateless
+ * handshake cookies.
+ */
+struct SipHashKey {
+    uint64_t k0 = 0;
+    uint64_t k1 = 0;
+};
+
+inline uint64_t sipHash24(const SipHashKey& key, const uint8_t* data, size_t size) {
+    auto rotl = [](uint64_t x, int b) { return (x << b) | (x >> (64 - b)); };
+    uint64_t v0 = 0x736f6d6570736575ull ^ key.k0;
+    uint64_t v1 = 0x646f72616e646f6dull ^ key.k1;
+    uint64_t v2 = 0x6c7967656e657261ull ^ key.k0;
+    uint64_t v3 = 0x7465646279746573ull ^ key.k1;
+    auto round = [&]() {
+        v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);
+        v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);
+    };
+    auto load = [](const uint8_t* p, size_t count) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < count; ++i) {
+            value |= static_cast<uint64_t>(p[i]) << (8 * i);  // Little endian
+        }
+        return value;
+    };
+
+    const size_t fullBlocks = size / 8;
+    for (size_t i = 0; i < fullBlocks; ++i) {
+        const uint64_t m = load(data + i * 8, 8);
+        v3 ^= m;
+        round();
+        round();
+        v0 ^= m;
+    }
+
+    const uint64_t last = (static_cast<uint64_t>(size & 0xFF) << 56) | load(data + fullBlocks * 8, size % 8);
+    v3 ^= last;
+    round();
+    round();
+    v0 ^= last;
+
+    v2 ^= 0xFF;
+    round();
+    round();
+    round();
+    round();
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+} // namespace game::network
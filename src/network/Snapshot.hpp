@@ -0,0 +1,432 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <SFML/System/Vector2.hpp>
+#include "BitStream.hpp"
+#include "../../include/common/types.hpp"
+
+namespace game::network {
+
+/**
+ * Entity State
+ *
+ * Network view of a single entity inside a snapshot.
+ * Colour is packed RGBA (sf::Color::toInteger()) so the network layer
+ * does not depend on sfml-graphics.
+ */
+struct EntityState {
+    game::EntityID id = game::INVALID_ENTITY;
+    uint32_t generation = 0;  // Entity::generation: a reused ID is a different entity
+    sf::Vector2f position;
+    sf::Vector2f size;
+    uint32_t color = 0xFFFFFFFF;
+    bool hasHealth = false;
+    float health = 0.0f;
+    float maxHealth = 0.0f;
+    bool hasKillCounter = false;
+    int32_t killCount = 0;
+};
+
+/**
+ * Snapshot
+ *
+ * Full world state as seen by one client.
+ * Entities are kept sorted by ID so two snapshots can be diffed with a
+ * single merge pass.
+ */
+struct Snapshot {
+    uint32_t sequence = 0;  // 0 = empty slot / no baseline
+    uint32_t tick = 0;      // Server simulation tick the state was captured at
+    uint32_t inputAck = 0;  // Newest input tick the server applied for this client
+    uint32_t serverTime = 0;  // Client only, not on the wire: server clock (ms) from the packet header
+    std::vector<EntityState> entities;
+
+    const EntityState* find(game::EntityID id) const {
+        auto it = std::lower_bound(entities.begin(), entities.end(), id,
+            [](const EntityState& state, game::EntityID value) { return state.id < value; });
+        if (it != entities.end() && it->id == id) {
+            return &(*it);
+        }
+        return nullptr;
+    }
+
+    void sortEntities() {
+        std::sort(entities.begin(), entities.end(),
+            [](const EntityState& a, const EntityState& b) { return a.id < b.id; });
+    }
+};
+
+/**
+ * Snapshot Ring
+ *
+ * Fixed-size history of recent snapshots indexed by sequence number.
+ * Slots are reused, so after warm-up storing a snapshot does not allocate.
+ */
+template<size_t Capacity>
+class SnapshotRing {
+public:
+    /**
+     * Get the slot for a sequence number (overwrites the oldest entry)
+     */
+    Snapshot& insert(uint32_t sequence) {
+        Snapshot& slot = slots[sequence % Capacity];
+        slot.sequence = sequence;
+        slot.tick = 0;
+        slot.inputAck = 0;
+        slot.serverTime = 0;
+        slot.entities.clear();
+        return slot;
+    }
+
+    /**
+     * Find a stored snapshot (nullptr if unknown or already overwritten)
+     */
+    const Snapshot* find(uint32_t sequence) const {
+        if (sequence == 0) return nullptr;
+        const Snapshot& slot = slots[sequence % Capacity];
+        return slot.sequence == sequence ? &slot : nullptr;
+    }
+
+    void clear() {
+        for (auto& slot : slots) {
+            slot.sequence = 0;
+            slot.entities.clear();
+        }
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    std::array<Snapshot, Capacity> slots;
+};
+
+constexpr size_t SNAPSHOT_HISTORY_SIZE = 32;  // 1.6 s at 20 Hz
+using SnapshotHistory = SnapshotRing<SNAPSHOT_HISTORY_SIZE>;
+
+/**
+ * Snapshot Spec
+ *
+ * Per-field quantization shared by server and client. Positions are
+ * quantized to 1/16 px inside the map bounds (plus a margin), so both
+ * sides must agree on the map size (sent in CONNECT_ACK).
+ */
+struct SnapshotSpec {
+    QuantizationSpec positionX;
+    QuantizationSpec positionY;
+    QuantizationSpec size;
+    QuantizationSpec health;
+
+    SnapshotSpec() : SnapshotSpec(sf::Vector2f(4096.0f, 4096.0f)) {}
+
+    explicit SnapshotSpec(const sf::Vector2f& mapSize)
+        : positionX(-MAP_MARGIN, mapSize.x + MAP_MARGIN, POSITION_RESOLUTION)
+        , positionY(-MAP_MARGIN, mapSize.y + MAP_MARGIN, POSITION_RESOLUTION)
+        , size(0.0f, 63.9375f, POSITION_RESOLUTION)  // 10 bits
+        , health(0.0f, 63.75f, 0.25f)                // 8 bits
+    {}
+
+    static constexpr float MAP_MARGIN = 64.0f;
+    static constexpr float POSITION_RESOLUTION = 1.0f / 16.0f;
+};
+
+/**
+ * Snapshot Codec
+ *
+ * Bit-packed delta encoding of a snapshot against a baseline both sides
+ * already have.
+ *
+ * Wire format (BitWriter):
+ *   32 bits sequence, 32 bits server tick,
+ *   varuint baseline distance (0 = full snapshot),
+ *   varuint input ack,
+ *   varuint changedCount,
+ *   changedCount x { varuint id gap, 6 bit fieldMask, fields in mask order },
+ *   varuint removedCount, removedCount x { varuint id gap }
+ *
+ * IDs are sorted, so each is sent as the gap to the previous one. The
+ * generation (varuint) is only sent for entities new to the receiver;
+ * an ID whose generation changed is sent in full, as a new entity.
+ */
+namespace SnapshotCodec {
+    enum FieldMask : uint8_t {
+        FIELD_POSITION = 1 << 0,
+        FIELD_SIZE = 1 << 1,
+        FIELD_COLOR = 1 << 2,
+        FIELD_HEALTH = 1 << 3,
+        FIELD_KILLS = 1 << 4,
+        FIELD_GENERATION = 1 << 5,
+        FIELD_ALL = FIELD_POSITION | FIELD_SIZE | FIELD_COLOR | FIELD_HEALTH | FIELD_KILLS | FIELD_GENERATION
+    };
+    constexpr uint32_t FIELD_MASK_BITS = 6;
+
+    /**
+     * Round a state to the values the receiver will decode, so diffs
+     * ignore sub-resolution changes
+     */
+    inline void quantize(EntityState& state, const SnapshotSpec& spec) {
+        state.position.x = spec.positionX.round(state.position.x);
+        state.position.y = spec.positionY.round(state.position.y);
+        state.size.x = spec.size.round(state.size.x);
+        state.size.y = spec.size.round(state.size.y);
+        // Fields behind a cleared presence flag are never sent
+        state.health = state.hasHealth ? spec.health.round(state.health) : 0.0f;
+        state.maxHealth = state.hasHealth ? spec.health.round(state.maxHealth) : 0.0f;
+        state.killCount = state.hasKillCounter ? state.killCount : 0;
+    }
+
+    inline uint8_t diff(const EntityState& current, const EntityState& baseline) {
+        if (current.generation != baseline.generation) {
+            return FIELD_ALL;  // ID reused: nothing of the old entity carries over
+        }
+        uint8_t mask = 0;
+        if (current.position != baseline.position) mask |= FIELD_POSITION;
+        if (current.size != baseline.size) mask |= FIELD_SIZE;
+        if (current.color != baseline.color) mask |= FIELD_COLOR;
+        if (current.hasHealth != baseline.hasHealth ||
+            current.health != baseline.health ||
+            current.maxHealth != baseline.maxHealth) mask |= FIELD_HEALTH;
+        if (current.hasKillCounter != baseline.hasKillCounter ||
+            current.killCount != baseline.killCount) mask |= FIELD_KILLS;
+        return mask;
+    }
+
+    inline void writeFields(BitWriter& writer, const EntityState& state, uint8_t mask, const SnapshotSpec& spec) {
+        writer.writeBits(mask, FIELD_MASK_BITS);
+        if (mask & FIELD_POSITION) {
+            writer.writeQuantized(state.position.x, spec.positionX);
+            writer.writeQuantized(state.position.y, spec.positionY);
+        }
+        if (mask & FIELD_SIZE) {
+            writer.writeQuantized(state.size.x, spec.size);
+            writer.writeQuantized(state.size.y, spec.size);
+        }
+        if (mask & FIELD_COLOR) {
+            writer.writeBits(state.color, 32);
+        }
+        if (mask & FIELD_HEALTH) {
+            writer.writeBool(state.hasHealth);
+            if (state.hasHealth) {
+                writer.writeQuantized(state.health, spec.health);
+                writer.writeQuantized(state.maxHealth, spec.health);
+            }
+        }
+        if (mask & FIELD_KILLS) {
+            writer.writeBool(state.hasKillCounter);
+            if (state.hasKillCounter) {
+                writer.writeVarInt(state.killCount);
+            }
+        }
+        if (mask & FIELD_GENERATION) {
+            writer.writeVarUint(state.generation);
+        }
+    }
+
+    inline bool readFields(BitReader& reader, EntityState& state, uint8_t mask, const SnapshotSpec& spec) {
+        if (mask & FIELD_POSITION) {
+            if (!reader.readQuantized(state.position.x, spec.positionX) ||
+                !reader.readQuantized(state.position.y, spec.positionY)) return false;
+        }
+        if (mask & FIELD_SIZE) {
+            if (!reader.readQuantized(state.size.x, spec.size) ||
+                !reader.readQuantized(state.size.y, spec.size)) return false;
+        }
+        if (mask & FIELD_COLOR) {
+            if (!reader.readBits(state.color, 32)) return false;
+        }
+        if (mask & FIELD_HEALTH) {
+            if (!reader.readBool(state.hasHealth)) return false;
+            if (state.hasHealth) {
+                if (!reader.readQuantized(state.health, spec.health) ||
+                    !reader.readQuantized(state.maxHealth, spec.health)) return false;
+            }
+        }
+        if (mask & FIELD_KILLS) {
+            if (!reader.readBool(state.hasKillCounter)) return false;
+            if (state.hasKillCounter) {
+                if (!reader.readVarInt(state.killCount)) return false;
+            }
+        }
+        if (mask & FIELD_GENERATION) {
+            if (!reader.readVarUint(state.generation)) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Encoded size of a varuint, in bits
+     */
+    inline size_t varUintBits(uint32_t value) {
+        size_t bits = 8;
+        while (value >= 0x80) {
+            value >>= 7;
+            bits += 8;
+        }
+        return bits;
+    }
+
+    /**
+     * Encoded size of writeFields(state, mask), in bits (includes the mask)
+     */
+    inline size_t fieldBits(const EntityState& state, uint8_t mask, const SnapshotSpec& spec) {
+        size_t bits = FIELD_MASK_BITS;
+        if (mask & FIELD_POSITION) bits += spec.positionX.bits + spec.positionY.bits;
+        if (mask & FIELD_SIZE) bits += spec.size.bits * 2;
+        if (mask & FIELD_COLOR) bits += 32;
+        if (mask & FIELD_HEALTH) bits += 1 + (state.hasHealth ? spec.health.bits * 2 : 0);
+        if (mask & FIELD_KILLS) {
+            bits += 1;
+            if (state.hasKillCounter) {
+                const int32_t kills = state.killCount;
+                bits += varUintBits((static_cast<uint32_t>(kills) << 1) ^ static_cast<uint32_t>(kills >> 31));
+            }
+        }
+        if (mask & FIELD_GENERATION) bits += varUintBits(state.generation);
+        return bits;
+    }
+
+    /**
+     * Write current snapshot as a delta against baseline
+     * Check writer.hasOverflowed() afterwards.
+     * @param baseline Snapshot the receiver acknowledged (nullptr = send full state)
+     */
+    inline void writeDelta(BitWriter& writer, const Snapshot& current, const Snapshot* baseline,
+                           const SnapshotSpec& spec) {
+        static const std::vector<EntityState> emptyEntities;
+        const auto& base = baseline ? baseline->entities : emptyEntities;
+
+        writer.writeBits(current.sequence, 32);
+        writer.writeBits(current.tick, 32);
+        writer.writeVarUint(baseline ? current.sequence - baseline->sequence : 0);
+        writer.writeVarUint(current.inputAck);
+
+        // First pass: count changed entities so the count can lead the list
+        uint32_t changedCount = 0;
+        size_t b = 0;
+        for (const EntityState& state : current.entities) {
+            while (b < base.size() && base[b].id < state.id) ++b;
+            if (b >= base.size() || base[b].id != state.id || diff(state, base[b]) != 0) {
+                ++changedCount;
+            }
+        }
+        writer.writeVarUint(changedCount);
+
+        game::EntityID previousID = 0;
+        b = 0;
+        for (const EntityState& state : current.entities) {
+            while (b < base.size() && base[b].id < state.id) ++b;
+
+            uint8_t mask = FIELD_ALL;
+            if (b < base.size() && base[b].id == state.id) {
+                mask = diff(state, base[b]);
+            }
+            if (mask != 0) {
+                writer.writeVarUint(state.id - previousID);
+                writeFields(writer, state, mask, spec);
+                previousID = state.id;
+            }
+        }
+
+        // Entities present in the baseline but gone now
+        uint32_t removedCount = 0;
+        size_t c = 0;
+        for (const EntityState& old : base) {
+            while (c < current.entities.size() && current.entities[c].id < old.id) ++c;
+            if (c >= current.entities.size() || current.entities[c].id != old.id) {
+                ++removedCount;
+            }
+        }
+        writer.writeVarUint(removedCount);
+
+        previousID = 0;
+        c = 0;
+        for (const EntityState& old : base) {
+            while (c < current.entities.size() && current.entities[c].id < old.id) ++c;
+            if (c >= current.entities.size() || current.entities[c].id != old.id) {
+                writer.writeVarUint(old.id - previousID);
+                previousID = old.id;
+            }
+        }
+    }
+
+    /**
+     * Read a delta snapshot and rebuild the full state into out
+     * @return False if the baseline is unknown or the payload is malformed
+     */
+    template<size_t Capacity>
+    bool readDelta(BitReader& reader, const SnapshotRing<Capacity>& history,
+                   const SnapshotSpec& spec, Snapshot& out) {
+        uint32_t sequence = 0, tick = 0, baselineDistance = 0, inputAck = 0, changedCount = 0;
+        if (!reader.readBits(sequence, 32) || !reader.readBits(tick, 32) || !reader.readVarUint(baselineDistance) ||
+            !reader.readVarUint(inputAck) || !reader.readVarUint(changedCount)) {
+            return false;
+        }
+
+        const Snapshot* baseline = nullptr;
+        if (baselineDistance != 0) {
+            baseline = history.find(sequence - baselineDistance);
+            if (!baseline) {
+                return false;  // Baseline already dropped, wait for a newer delta
+            }
+        }
+
+        out.sequence = sequence;
+        out.tick = tick;
+        out.inputAck = inputAck;
+        out.entities.clear();
+        if (baseline) {
+            out.entities = baseline->entities;
+        }
+
+        // Changed entities arrive in ID order, so new ones are appended
+        // and the list is re-sorted once at the end
+        const size_t baseCount = out.entities.size();
+        game::EntityID id = 0;
+        for (uint32_t i = 0; i < changedCount; ++i) {
+            uint32_t gap, mask;
+            if (!reader.readVarUint(gap) || !reader.readBits(mask, FIELD_MASK_BITS)) return false;
+            id += gap;
+
+            auto begin = out.entities.begin();
+            auto end = begin + static_cast<std::ptrdiff_t>(baseCount);
+            auto it = std::lower_bound(begin, end, id,
+                [](const EntityState& state, game::EntityID value) { return state.id < value; });
+            EntityState* state = nullptr;
+            if (it != end && it->id == id) {
+                state = &(*it);
+            } else {
+                out.entities.emplace_back();
+                state = &out.entities.back();
+                state->id = id;
+            }
+            if (!readFields(reader, *state, static_cast<uint8_t>(mask), spec)) return false;
+        }
+
+        // Removed IDs come from the baseline part of the list in ascending
+        // order, so a single forward cursor finds them all
+        uint32_t removedCount = 0;
+        if (!reader.readVarUint(removedCount)) return false;
+        size_t cursor = 0;
+        id = 0;
+        for (uint32_t i = 0; i < removedCount; ++i) {
+            uint32_t gap;
+            if (!reader.readVarUint(gap)) return false;
+            id += gap;
+            while (cursor < baseCount && out.entities[cursor].id < id) ++cursor;
+            if (cursor < baseCount && out.entities[cursor].id == id) {
+                out.entities[cursor].id = game::INVALID_ENTITY;  // Tombstone, compacted below
+                ++cursor;
+            }
+        }
+
+        out.entities.erase(std::remove_if(out.entities.begin(), out.entities.end(),
+            [](const EntityState& state) { return state.id == game::INVALID_ENTITY; }),
+            out.entities.end());
+        out.sortEntities();
+        return true;
+    }
+}
+
+} // namespace game::network
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+namespace game::network {
+
+/**
+ * Single-Producer / Single-Consumer Queue
+ *
+ * Lock-free bounded ring for handing items between exactly two threads.
+ * Slots are allocated once; the producer fills slots in place
+ * (prepare/commit) and the consumer reads them in place (front/pop), so
+ * large items such as datagrams are never copied through the queue.
+ * Both sides can work on a batch of slots and publish it at once.
+ *
+ * @tparam Capacity Number of slots (power of two)
+ */
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() : slots(std::make_unique<T[]>(Capacity)) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side
+
+    /**
+     * Slot to fill, or nullptr if the queue is full
+     */
+    T* prepare() {
+        return writable() > 0 ? prepare(0) : nullptr;
+    }
+
+    /**
+     * Number of slots the producer can fill before the next commit
+     */
+    size_t writable() {
+        const size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - cachedHead >= Capacity) {
+            cachedHead = headIndex.load(std::memory_order_acquire);
+        }
+        return Capacity - (tail - cachedHead);
+    }
+
+    /**
+     * Slot offset places after the next free one (offset < writable())
+     * Lets a batch be filled in place before one commit(count).
+     */
+    T* prepare(size_t offset) {
+        return &slots[(tailIndex.load(std::memory_order_relaxed) + offset) & (Capacity - 1)];
+    }
+
+    /**
+     * Publish the next count prepared slots
+     */
+    void commit(size_t count = 1) {
+        tailIndex.store(tailIndex.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    bool push(const T& item) {
+        T* slot = prepare();
+        if (!slot) return false;
+        *slot = item;
+        commit();
+        return true;
+    }
+
+    // Consumer side
+
+    /**
+     * Oldest item, or nullptr if the queue is empty
+     */
+    T* front() {
+        return readable() > 0 ? front(0) : nullptr;
+    }
+
+    /**
+     * Number of items the consumer can read before the next pop
+     */
+    size_t readable() {
+        const size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == cachedTail) {
+            cachedTail = tailIndex.load(std::memory_order_acquire);
+        }
+        return cachedTail - head;
+    }
+
+    /**
+     * Item offset places after the oldest one (offset < readable())
+     */
+    T* front(size_t offset) {
+        return &slots[(headIndex.load(std::memory_order_relaxed) + offset) & (Capacity - 1)];
+    }
+
+    /**
+     * Release the next count items
+     */
+    void pop(size_t count = 1) {
+        headIndex.store(headIndex.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    bool empty() const {
+        return headIndex.load(std::memory_order_acquire) == tailIndex.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::unique_ptr<T[]> slots;
+
+    // Each index on its own cache line; each side caches the other's index
+    // so the shared line is only touched when the cached value runs out
+    alignas(CACHE_LINE) std::atomic<size_t> headIndex{0};  // Written by consumer
+    size_t cachedTail = 0;                                 // Consumer's view of tail
+    alignas(CACHE_LINE) std::atomic<size_t> tailIndex{0};  // Written by producer
+    size_t cachedHead = 0;                                 // Producer's view of head
+};
+
+} // namespace game::network
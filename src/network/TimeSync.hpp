@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+namespace game::network {
+
+/**
+ * Time Sync
+ *
+ * Per-peer latency and clock estimate:
+ * - RTT: smoothed RTT and RTT variance (RFC 6298), fed by packet acks
+ *   (ReliableEndpoint) and heartbeat echoes.
+ * - Clock offset: remote clock = local clock + offset. Each heartbeat
+ *   echoes the peer's last heartbeat timestamp and how long it was held,
+ *   which gives one RTT sample and one offset sample (remote timestamp +
+ *   RTT/2). The offset of the lowest-RTT sample among the last few is
+ *   used, since queueing delay only ever adds to a sample.
+ *
+ * Timestamps are the u32 millisecond values of the packet header
+ * (localTimeMs()); differences are taken modulo 2^32.
+ */
+class TimeSync {
+public:
+    static constexpr float INITIAL_RTT = 0.1f;     // Seconds, until the first sample
+    static constexpr size_t CLOCK_SAMPLES = 8;
+    static constexpr uint32_t MAX_SAMPLE_RTT_MS = 10000;  // Older echoes are stale
+
+    /**
+     * Local clock for packet timestamps (milliseconds, wraps every ~49 days)
+     */
+    static uint32_t localTimeMs() {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * Add a round-trip measurement (seconds)
+     */
+    void addRttSample(float seconds) {
+        if (!hasRtt) {
+            srtt = seconds;
+            rttvar = seconds * 0.5f;
+            hasRtt = true;
+            return;
+        }
+        rttvar = 0.75f * rttvar + 0.25f * std::abs(srtt - seconds);
+        srtt = 0.875f * srtt + 0.125f * seconds;
+    }
+
+    /**
+     * Remember a heartbeat timestamp from the peer, to echo it back
+     */
+    void onRemoteHeartbeat(uint32_t remoteTimestamp, uint32_t nowMs) {
+        lastRemoteTimestamp = remoteTimestamp;
+        lastRemoteArrival = nowMs;
+        hasRemoteTimestamp = true;
+    }
+
+    /**
+     * Echo for our next heartbeat: the peer's last timestamp and how long
+     * we've held it (both 0 if nothing was received yet)
+     */
+    void getEcho(uint32_t nowMs, uint32_t& echoTimestamp, uint32_t& holdMs) const {
+        echoTimestamp = hasRemoteTimestamp ? lastRemoteTimestamp : 0;
+        holdMs = hasRemoteTimestamp ? nowMs - lastRemoteArrival : 0;
+    }
+
+    /**
+     * Process the echo in a heartbeat from the peer
+     * @param remoteTimestamp Header timestamp of that heartbeat (peer clock)
+     * @param echoTimestamp Our timestamp the peer echoed (0 = none)
+     * @param holdMs How long the peer held our timestamp before echoing
+     */
+    void onEcho(uint32_t remoteTimestamp, uint32_t echoTimestamp, uint32_t holdMs, uint32_t nowMs) {
+        if (echoTimestamp == 0) {
+            return;
+        }
+        const uint32_t elapsed = nowMs - echoTimestamp;
+        if (elapsed < holdMs || elapsed - holdMs > MAX_SAMPLE_RTT_MS) {
+            return;  // Clock went backwards or the echo is stale
+        }
+        const uint32_t rttMs = elapsed - holdMs;
+        addRttSample(static_cast<float>(rttMs) / 1000.0f);
+
+        ClockSample& sample = clockSamples[clockSampleCount++ % CLOCK_SAMPLES];
+        sample.rttMs = rttMs;
+        sample.offsetMs = static_cast<int32_t>(remoteTimestamp + rttMs / 2 - nowMs);
+
+        const size_t count = std::min(clockSampleCount, CLOCK_SAMPLES);
+        const ClockSample* best = &clockSamples[0];
+        for (size_t i = 1; i < count; ++i) {
+            if (clockSamples[i].rttMs < best->rttMs) {
+                best = &clockSamples[i];
+            }
+        }
+        clockOffsetMs = best->offsetMs;
+    }
+
+    /**
+     * Smoothed round-trip time and its variance (seconds)
+     */
+    float getRtt() const { return srtt; }
+    float getRttVariance() const { return rttvar; }
+    bool hasRttSample() const { return hasRtt; }
+
+    /**
+     * Remote clock minus local clock (milliseconds); valid once
+     * hasClockOffset() is true
+     */
+    int32_t getClockOffsetMs() const { return clockOffsetMs; }
+    bool hasClockOffset() const { return clockSampleCount > 0; }
+
+    uint32_t toRemoteTime(uint32_t localMs) const { return localMs + static_cast<uint32_t>(clockOffsetMs); }
+    uint32_t toLocalTime(uint32_t remoteMs) const { return remoteMs - static_cast<uint32_t>(clockOffsetMs); }
+
+private:
+    struct ClockSample {
+        uint32_t rttMs = 0;
+        int32_t offsetMs = 0;
+    };
+
+    float srtt = INITIAL_RTT;
+    float rttvar = INITIAL_RTT * 0.5f;
+    bool hasRtt = false;
+
+    std::array<ClockSample, CLOCK_SAMPLES> clockSamples;
+    size_t clockSampleCount = 0;
+    int32_t clockOffsetMs = 0;
+
+    uint32_t lastRemoteTimestamp = 0;
+    uint32_t lastRemoteArrival = 0;
+    bool hasRemoteTimestamp = false;
+};
+
+} // namespace game::network
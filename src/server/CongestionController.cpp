@@ -0,0 +1,87 @@
+#include "CongestionController.hpp"
+#include <algorithm>
+
+namespace game::server {
+
+CongestionController::CongestionController()
+    : CongestionController(Settings()) {
+}
+
+CongestionController::CongestionController(const Settings& settings)
+    : settings(settings)
+    , rate(std::clamp(settings.initialRate, settings.minRate, std::max(settings.minRate, settings.maxRate)))
+    , snapshotBytes(settings.maxSnapshotBytes) {
+}
+
+void CongestionController::setClientCap(int rateCap) {
+    clientCap = rateCap > 0 ? rateCap : 0;
+    rate = std::min(rate, rateLimit());
+}
+
+bool CongestionController::update(const game::network::ReliableEndpoint::Stats& stats,
+                                  const game::network::TimeSync& timeSync, Clock::time_point now) {
+    if (!started) {
+        started = true;
+        lastEvaluation = now;
+        lastAcked = stats.packetsAcked;
+        lastLost = stats.packetsLost;
+        return false;
+    }
+    if (std::chrono::duration<float>(now - lastEvaluation).count() < settings.evaluationInterval) {
+        return false;
+    }
+    lastEvaluation = now;
+
+    // Loss over the period
+    const uint64_t acked = stats.packetsAcked - lastAcked;
+    const uint64_t lost = stats.packetsLost - lastLost;
+    lastAcked = stats.packetsAcked;
+    lastLost = stats.packetsLost;
+    lastLoss = acked + lost >= MIN_LOSS_SAMPLES ? static_cast<float>(lost) / static_cast<float>(acked + lost) : 0.0f;
+
+    // Queueing shows up as RTT above the best seen (slowly forgotten, so a
+    // route change doesn't look like congestion forever)
+    bool rttGrowing = false;
+    if (timeSync.hasRttSample()) {
+        const float rtt = timeSync.getRtt();
+        baselineRtt = hasBaseline ? std::min(rtt, baselineRtt + BASELINE_DECAY) : rtt;
+        hasBaseline = true;
+        rttGrowing = rtt - baselineRtt > settings.rttGrowthThreshold;
+    }
+
+    const int previousRate = rate;
+    const int previousBytes = snapshotBytes;
+    congested = lastLoss > settings.lossThreshold || rttGrowing;
+    if (congested) {
+        goodPeriods = 0;
+        if (rate > settings.minRate) {
+            rate = std::max(settings.minRate, rate / 2);
+        } else {
+            snapshotBytes = std::max(settings.minSnapshotBytes, snapshotBytes * 3 / 4);
+        }
+    } else if (++goodPeriods >= settings.recoveryPeriods) {
+        goodPeriods = 0;
+        if (snapshotBytes < settings.maxSnapshotBytes) {
+            snapshotBytes = std::min(settings.maxSnapshotBytes, snapshotBytes * 4 / 3 + 1);
+        } else {
+            rate = std::min(rateLimit(), rate + settings.rateStep);
+        }
+    }
+
+    if (rate < previousRate || snapshotBytes < previousBytes) {
+        ++decreases;
+    }
+    return rate != previousRate || snapshotBytes != previousBytes;
+}
+
+int CongestionController::getSnapshotByteBudget() const {
+    const int bandwidthShare = settings.bytesPerSecond / rate;
+    return std::max(settings.minSnapshotBytes, std::min(snapshotBytes, bandwidthShare));
+}
+
+int CongestionController::rateLimit() const {
+    const int limit = clientCap > 0 ? std::min(settings.maxRate, clientCap) : settings.maxRate;
+    return std::max(settings.minRate, limit);
+}
+
+} // namespace game::server
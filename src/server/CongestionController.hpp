@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include "../network/ReliableEndpoint.hpp"
+#include "../network/TimeSync.hpp"
+
+namespace game::server {
+
+/**
+ * Congestion Controller
+ *
+ * Per-client snapshot rate and snapshot byte budget. Once per evaluation
+ * interval the connection's packet loss (from ReliableEndpoint) and RTT
+ * growth over its best RTT (from TimeSync) are checked:
+ * - Congested: halve the rate (down to minRate); at minRate, shrink the
+ *   per-snapshot byte budget instead
+ * - Good for recoveryPeriods in a row: restore the byte budget first,
+ *   then raise the rate by rateStep (up to maxRate and the client's cap)
+ *
+ * The byte budget never exceeds bytesPerSecond / rate, so faster clients
+ * get smaller snapshots rather than more bandwidth.
+ */
+class CongestionController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        int initialRate = 20;         // Snapshots per second
+        int minRate = 10;
+        int maxRate = 60;
+        int rateStep = 5;             // Increase per good period
+        int maxSnapshotBytes = 1200;  // Per-snapshot budget when uncongested
+        int minSnapshotBytes = 300;
+        int bytesPerSecond = 48000;   // Snapshot bandwidth cap per client
+        float lossThreshold = 0.05f;  // Loss fraction counted as congestion
+        float rttGrowthThreshold = 0.05f;  // Seconds above the best RTT
+        float evaluationInterval = 1.0f;   // Seconds
+        int recoveryPeriods = 2;
+    };
+
+    static constexpr uint64_t MIN_LOSS_SAMPLES = 10;  // Packets judged before loss counts
+    static constexpr float BASELINE_DECAY = 0.002f;   // Best RTT forgotten per evaluation (s)
+
+    CongestionController();
+    explicit CongestionController(const Settings& settings);
+
+    /**
+     * Rate the client asked for at most (0 = no cap)
+     */
+    void setClientCap(int rate);
+
+    /**
+     * Re-evaluate if the evaluation interval has passed
+     * @return True if the rate or byte budget changed
+     */
+    bool update(const game::network::ReliableEndpoint::Stats& stats, const game::network::TimeSync& timeSync,
+                Clock::time_point now);
+
+    int getSnapshotRate() const { return rate; }
+    float getSnapshotInterval() const { return 1.0f / static_cast<float>(rate); }
+    int getSnapshotByteBudget() const;
+    bool isCongested() const { return congested; }
+    float getLastLoss() const { return lastLoss; }
+
+    /**
+     * Times the rate or budget was cut (diagnostics)
+     */
+    uint64_t getDecreaseCount() const { return decreases; }
+
+private:
+    Settings settings;
+    int clientCap = 0;
+    int rate;
+    int snapshotBytes;
+
+    bool started = false;
+    Clock::time_point lastEvaluation;
+    uint64_t lastAcked = 0;
+    uint64_t lastLost = 0;
+    float baselineRtt = 0.0f;
+    bool hasBaseline = false;
+
+    bool congested = false;
+    int goodPeriods = 0;
+    float lastLoss = 0.0f;
+    uint64_t decreases = 0;
+
+    int rateLimit() const;
+};
+
+} // namespace game::server
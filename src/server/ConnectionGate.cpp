@@ -0,0 +1,88 @@
+#include "ConnectionGate.hpp"
+#include <algorithm>
+#include <random>
+
+namespace game::server {
+
+ConnectionGate::ConnectionGate()
+    : ConnectionGate(Settings()) {
+}
+
+ConnectionGate::ConnectionGate(const Settings& settings)
+    : settings(settings)
+    , epoch(Clock::now()) {
+    std::random_device random;
+    auto random64 = [&random]() {
+        return (static_cast<uint64_t>(random()) << 32) | static_cast<uint64_t>(random());
+    };
+    secret.k0 = random64();
+    secret.k1 = random64();
+
+    size_t count = 1;
+    while (count < settings.bucketCount) {
+        count <<= 1;
+    }
+    buckets.resize(count);
+}
+
+bool ConnectionGate::allow(const game::network::Address& address, Clock::time_point now) {
+    const uint32_t ip = address.getIpAddress().toInteger();
+    uint8_t bytes[4] = {
+        static_cast<uint8_t>(ip), static_cast<uint8_t>(ip >> 8),
+        static_cast<uint8_t>(ip >> 16), static_cast<uint8_t>(ip >> 24)
+    };
+    // Keyed, so nobody can pick IPs that share a bucket on purpose. IPs
+    // that do share one share its tokens: handing a colliding IP a fresh
+    // burst would let a spoofed flood reset the limit of every IP it hits.
+    Bucket& bucket = buckets[game::network::sipHash24(secret, bytes, sizeof(bytes)) & (buckets.size() - 1)];
+
+    if (!bucket.used) {
+        bucket.used = true;
+        bucket.tokens = settings.connectBurst;
+    } else {
+        const float elapsed = std::chrono::duration<float>(now - bucket.lastRefill).count();
+        bucket.tokens = std::min(settings.connectBurst, bucket.tokens + elapsed * settings.connectRate);
+    }
+    bucket.lastRefill = now;
+
+    if (bucket.tokens < 1.0f) {
+        ++stats.rateLimited;
+        return false;
+    }
+    bucket.tokens -= 1.0f;
+    return true;
+}
+
+ConnectionGate::Cookie ConnectionGate::issue(const game::network::Address& address, Clock::time_point now) const {
+    Cookie cookie;
+    cookie.window = windowAt(now);
+    cookie.mac = mac(address, cookie.window);
+    return cookie;
+}
+
+bool ConnectionGate::verify(const game::network::Address& address, const Cookie& cookie, Clock::time_point now) const {
+    const uint32_t window = windowAt(now);
+    if (cookie.window != window && cookie.window + 1 != window) {
+        return false;  // Expired (or from the future)
+    }
+    return cookie.mac == mac(address, cookie.window);
+}
+
+uint32_t ConnectionGate::windowAt(Clock::time_point now) const {
+    const float elapsed = std::chrono::duration<float>(now - epoch).count();
+    return static_cast<uint32_t>(elapsed / std::max(settings.cookieLifetime, 0.1f));
+}
+
+uint64_t ConnectionGate::mac(const game::network::Address& address, uint32_t window) const {
+    const uint64_t key = address.toKey();  // IPv4 + port
+    uint8_t bytes[10];
+    for (int i = 0; i < 6; ++i) {
+        bytes[i] = static_cast<uint8_t>(key >> (8 * i));
+    }
+    for (int i = 0; i < 4; ++i) {
+        bytes[6 + i] = static_cast<uint8_t>(window >> (8 * i));
+    }
+    return game::network::sipHash24(secret, bytes, sizeof(bytes));
+}
+
+} // namespace game::server
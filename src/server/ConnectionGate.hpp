@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "../network/Address.hpp"
+#include "../network/SipHash.hpp"
+
+namespace game::server {
+
+/**
+ * Connection Gate
+ *
+ * Guards connection setup without keeping state per unverified sender:
+ * - CONNECT is answered with a cookie, a MAC (SipHash, secret key) over
+ *   the sender's address and the current time window. Nothing is stored.
+ * - The client echoes the cookie in CHALLENGE_RESPONSE; only a cookie
+ *   that verifies for that address in the current or previous window
+ *   leads to a connection, so spoofed source addresses never get one.
+ * - Connect attempts are rate limited per IP with a token bucket. The
+ *   buckets live in a fixed table indexed by keyed hash; colliding IPs
+ *   share a bucket (memory stays bounded under a flood, and no IP gets
+ *   more than connectRate however many others hit its bucket).
+ */
+class ConnectionGate {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        float cookieLifetime = 5.0f;  // Seconds per window (a cookie lives 1-2 windows)
+        float connectRate = 2.0f;     // Attempts per second per IP
+        float connectBurst = 5.0f;    // Attempts allowed at once
+        size_t bucketCount = 1024;    // Rate limit table size (power of two)
+    };
+
+    struct Cookie {
+        uint32_t window = 0;
+        uint64_t mac = 0;
+    };
+
+    struct Stats {
+        uint64_t challengesSent = 0;
+        uint64_t cookiesRejected = 0;  // Wrong MAC or expired
+        uint64_t rateLimited = 0;
+        uint64_t rejectedFull = 0;     // Server at maxPlayers
+    };
+
+    ConnectionGate();
+    explicit ConnectionGate(const Settings& settings);
+
+    /**
+     * Take a token from the IP's bucket
+     * @return False if the IP is over its connect rate
+     */
+    bool allow(const game::network::Address& address, Clock::time_point now);
+
+    /**
+     * Cookie for an address in the current window
+     */
+    Cookie issue(const game::network::Address& address, Clock::time_point now) const;
+
+    /**
+     * Check an echoed cookie (current or previous window)
+     */
+    bool verify(const game::network::Address& address, const Cookie& cookie, Clock::time_point now) const;
+
+    Stats& getStats() { return stats; }
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Bucket {
+        bool used = false;
+        float tokens = 0.0f;
+        Clock::time_point lastRefill;
+    };
+
+    Settings settings;
+    game::network::SipHashKey secret;  // Random per server run
+    Clock::time_point epoch;           // Window 0 starts here
+    std::vector<Bucket> buckets;
+    Stats stats;
+
+    uint32_t windowAt(Clock::time_point now) const;
+    uint64_t mac(const game::network::Address& address, uint32_t window) const;
+};
+
+} // namespace game::server
@@ -0,0 +1,100 @@
+#include "ConnectionTable.hpp"
+
+namespace game::server {
+
+ConnectionTable::ConnectionTable(size_t capacity) {
+    reset(capacity);
+}
+
+void ConnectionTable::reset(size_t capacity) {
+    capacity = capacity > 0 ? capacity : 1;
+
+    slots.clear();
+    slots.resize(capacity);
+    slotKeys.assign(capacity, EMPTY_KEY);
+    activePosition.assign(capacity, 0);
+    active.clear();
+    active.reserve(capacity);
+    freeSlots.clear();
+    freeSlots.reserve(capacity);
+    for (size_t i = capacity; i-- > 0;) {
+        freeSlots.push_back(static_cast<Slot>(i));  // Lowest slot is handed out first
+    }
+
+    size_t indexSize = 2;
+    uint32_t bits = 1;
+    while (indexSize < capacity * 2) {
+        indexSize <<= 1;
+        ++bits;
+    }
+    index.assign(indexSize, IndexEntry());
+    indexShift = 64 - bits;
+}
+
+size_t ConnectionTable::findPosition(uint64_t key) const {
+    for (size_t position = home(key);; position = (position + 1) & mask()) {
+        const IndexEntry& entry = index[position];
+        if (entry.key == key || entry.key == EMPTY_KEY) {
+            return position;
+        }
+    }
+}
+
+ConnectionTable::Slot ConnectionTable::find(const game::network::Address& address) const {
+    return index[findPosition(address.toKey())].slot;
+}
+
+ConnectionTable::Slot ConnectionTable::insert(const game::network::Address& address) {
+    const uint64_t key = address.toKey();
+    IndexEntry& entry = index[findPosition(key)];
+    if (entry.key == key) {
+        return entry.slot;
+    }
+    if (freeSlots.empty()) {
+        return INVALID_SLOT;
+    }
+
+    const Slot slot = freeSlots.back();
+    freeSlots.pop_back();
+    entry.key = key;
+    entry.slot = slot;
+    slotKeys[slot] = key;
+    activePosition[slot] = static_cast<uint32_t>(active.size());
+    active.push_back(slot);
+    slots[slot] = ClientConnection();
+    return slot;
+}
+
+void ConnectionTable::erase(Slot slot) {
+    if (slot >= slots.size() || slotKeys[slot] == EMPTY_KEY) {
+        return;
+    }
+
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    size_t hole = findPosition(slotKeys[slot]);
+    for (size_t next = (hole + 1) & mask(); index[next].key != EMPTY_KEY; next = (next + 1) & mask()) {
+        const size_t nextHome = home(index[next].key);
+        if (((next - nextHome) & mask()) >= ((next - hole) & mask())) {
+            index[hole] = index[next];
+            hole = next;
+        }
+    }
+    index[hole] = IndexEntry();
+
+    // Keep the active list dense
+    const uint32_t position = activePosition[slot];
+    const Slot last = active.back();
+    active[position] = last;
+    activePosition[last] = position;
+    active.pop_back();
+
+    slotKeys[slot] = EMPTY_KEY;
+    slots[slot] = ClientConnection();  // Release buffers now rather than on reuse
+    freeSlots.push_back(slot);
+}
+
+void ConnectionTable::clear() {
+    reset(slots.size());
+}
+
+} // namespace game::server
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <SFML/System/Vector2.hpp>
+#include "../network/Address.hpp"
+#include "../network/Snapshot.hpp"
+#include "../network/ReliableEndpoint.hpp"
+#include "../core/Entity.hpp"
+#include "PriorityAccumulator.hpp"
+#include "InputJitterBuffer.hpp"
+#include "CongestionController.hpp"
+#include "ShotQueue.hpp"
+
+namespace game::server {
+
+/**
+ * Client Connection Info
+ */
+struct ClientConnection {
+    game::network::Address address;
+    game::core::Entity entity;
+    std::chrono::steady_clock::time_point lastHeartbeat;
+    bool connected;
+    sf::Vector2f initialPosition;  // Sent with CONNECT
+    uint32_t shard = 0;            // Socket / I/O thread the client's datagrams arrive on
+
+    // Snapshots sent to this client (delta baselines)
+    game::network::SnapshotHistory snapshots;
+    uint32_t lastAckedSnapshot = 0;  // Newest snapshot the client confirmed (0 = none)
+    PriorityAccumulator priorities;  // Which changed entities make the next snapshot
+    CongestionController congestion; // Snapshot rate and byte budget
+    std::chrono::steady_clock::time_point nextSnapshotTime;  // Due when reached
+
+    // Movement input, one command per server tick
+    InputJitterBuffer inputBuffer;
+
+    // SHOOT commands waiting for ShootingSystem (cooldown enforced there)
+    ShotQueue shots;
+
+    // Packet acks, RTT and reliable/unreliable message channels
+    game::network::ReliableEndpoint reliable;
+
+    ClientConnection() : connected(false) {}
+    ClientConnection(const game::network::Address& addr, const game::core::Entity& ent)
+        : address(addr), entity(ent), connected(true) {
+        lastHeartbeat = std::chrono::steady_clock::now();
+    }
+};
+
+/**
+ * Connection Table
+ *
+ * Client connections in a fixed array of slots. A slot index stays valid
+ * for the lifetime of its connection, so per-packet and per-tick code
+ * works with indices; the address is only looked up once per received
+ * datagram, through an open-addressed (linear probing) index keyed by
+ * the packed IPv4 + port (Address::toKey()). No allocation after setup.
+ *
+ * Iteration visits the active slots only (dense list, unordered).
+ */
+class ConnectionTable {
+public:
+    using Slot = uint32_t;
+    static constexpr Slot INVALID_SLOT = 0xFFFFFFFFu;
+
+    /**
+     * @param capacity Maximum simultaneous connections
+     */
+    explicit ConnectionTable(size_t capacity = 128);
+
+    /**
+     * Drop all connections and resize
+     */
+    void reset(size_t capacity);
+
+    /**
+     * Slot of an address (INVALID_SLOT if unknown)
+     */
+    Slot find(const game::network::Address& address) const;
+
+    /**
+     * Slot for a new address, with a default-constructed connection
+     * (the existing slot if the address is already present)
+     * @return INVALID_SLOT if the table is full
+     */
+    Slot insert(const game::network::Address& address);
+
+    /**
+     * Free a slot; other slots keep their index
+     */
+    void erase(Slot slot);
+
+    void clear();
+
+    ClientConnection& operator[](Slot slot) { return slots[slot]; }
+    const ClientConnection& operator[](Slot slot) const { return slots[slot]; }
+
+    size_t size() const { return active.size(); }
+    size_t capacity() const { return slots.size(); }
+    bool empty() const { return active.empty(); }
+
+    /**
+     * Slots in use; erase() moves the last entry into the erased position,
+     * so erase while walking this backwards
+     */
+    const std::vector<Slot>& getActiveSlots() const { return active; }
+
+    template<typename Connection, typename Table>
+    class BasicIterator {
+    public:
+        BasicIterator(Table* table, std::vector<Slot>::const_iterator it) : table(table), it(it) {}
+        Connection& operator*() const { return table->slots[*it]; }
+        Connection* operator->() const { return &table->slots[*it]; }
+        BasicIterator& operator++() { ++it; return *this; }
+        bool operator!=(const BasicIterator& other) const { return it != other.it; }
+        bool operator==(const BasicIterator& other) const { return it == other.it; }
+    private:
+        Table* table;
+        std::vector<Slot>::const_iterator it;
+    };
+    using Iterator = BasicIterator<ClientConnection, ConnectionTable>;
+    using ConstIterator = BasicIterator<const ClientConnection, const ConnectionTable>;
+
+    Iterator begin() { return Iterator(this, active.begin()); }
+    Iterator end() { return Iterator(this, active.end()); }
+    ConstIterator begin() const { return ConstIterator(this, active.begin()); }
+    ConstIterator end() const { return ConstIterator(this, active.end()); }
+
+private:
+    static constexpr uint64_t EMPTY_KEY = ~0ull;  // Keys only use 48 bits
+
+    struct IndexEntry {
+        uint64_t key = EMPTY_KEY;
+        Slot slot = INVALID_SLOT;
+    };
+
+    std::vector<ClientConnection> slots;
+    std::vector<uint64_t> slotKeys;       // Key per slot (EMPTY_KEY = free)
+    std::vector<uint32_t> activePosition; // Position of each slot in active
+    std::vector<Slot> active;
+    std::vector<Slot> freeSlots;
+
+    std::vector<IndexEntry> index;  // Power of two, at most half full
+    uint32_t indexShift = 0;        // 64 - log2(index size)
+
+    size_t home(uint64_t key) const {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> indexShift);  // Fibonacci hashing
+    }
+    size_t mask() const { return index.size() - 1; }
+    size_t findPosition(uint64_t key) const;
+};
+
+} // namespace game::server
@@ -1,9 +1,11 @@
 #include "GameServer.hpp"
 #include "../network/Packet.hpp"
 #include "../network/PacketTypes.hpp"
+#include "../network/Fragmentation.hpp"
 #include "../core/systems/MovementSystem.hpp"
 #include "../core/components/HealthComponent.hpp"
 #include "../core/components/KillCounterComponent.hpp"
+#include "../core/components/ProjectileComponent.hpp"
 #include "systems/CollisionSystem.hpp"
 #include "systems/ShootingSystem.hpp"
 #include "systems/ProjectileSystem.hpp"
@@ -14,6 +16,7 @@
 #include <cmath>
 #include <chrono>
 #include <random>
+#include <algorithm>
 
 namespace game::server {
 
@@ -30,33 +33,60 @@ bool GameServer::initialize(const ServerConfig& cfg) {
     config = cfg;
     
     // Initialize network
-    if (!networkManager.initialize(config.port)) {
+    if (!networkManager.initialize(config.port, config.networkThread, config.batchedSocketIo, config.socketShards)) {
         return false;
     }
+    networkManager.setMaxClients(static_cast<size_t>(config.maxPlayers));
+    networkManager.configureInputBuffer(config.inputBufferDelay, config.inputMaxHoldTicks);
+    networkManager.configureShots(config.weaponCooldownTicks, config.shotToleranceTicks);
+    
+    CongestionController::Settings congestion;
+    congestion.initialRate = config.snapshotRate;
+    congestion.minRate = config.snapshotRateMin;
+    congestion.maxRate = std::min(config.snapshotRateMax, config.tickRate);  // No new state between ticks
+    congestion.maxSnapshotBytes = config.snapshotByteBudget;
+    congestion.bytesPerSecond = config.snapshotBandwidth;
+    congestion.lossThreshold = config.congestionLossThreshold;
+    congestion.rttGrowthThreshold = config.congestionRttGrowth;
+    networkManager.configureCongestion(congestion);
+    
+    ConnectionGate::Settings handshake;
+    handshake.cookieLifetime = config.connectCookieLifetime;
+    handshake.connectRate = config.connectRatePerIp;
+    handshake.connectBurst = config.connectBurstPerIp;
+    networkManager.configureHandshake(handshake);
     
     // Load colliders (static obstacles)
     loadColliders();
     
+    snapshotSpec = game::network::SnapshotSpec(mapSize);
+    snapshotBuffer.resize(game::network::MAX_FRAGMENTED_SIZE);
+    interestGrid = SpatialGrid(config.interestCellSize);
+    lagCompensation.configure(config.lagCompensationTicks(), static_cast<size_t>(config.maxPlayers));
+    
     // Initialize world and register systems
+    world = game::core::World(config.archetypeStorage ? game::core::StorageBackend::Archetype
+                                                      : game::core::StorageBackend::SparseSet);
     // IMPORTANT: System execution order (by priority):
     // - ShootingSystem: 10 (processes SHOOT packets, spawns projectiles)
     // - CollisionSystem: 50 (checks collisions before movement)
     // - ProjectileSystem: 75 (updates projectile lifetime, checks collisions)
     // - MovementSystem: 100 (updates positions based on velocity)
-    world.registerSystem(std::make_unique<systems::ShootingSystem>(networkManager));
+    world.registerSystem(std::make_unique<systems::ShootingSystem>(networkManager, lagCompensation));
     world.registerSystem(std::make_unique<systems::CollisionSystem>(colliders));
-    world.registerSystem(std::make_unique<systems::ProjectileSystem>(colliders));
+    world.registerSystem(std::make_unique<systems::ProjectileSystem>(colliders, lagCompensation));
     world.registerSystem(std::make_unique<game::core::systems::MovementSystem>());
     world.initialize();
     
     running = true;
     lastUpdateTime = std::chrono::steady_clock::now();
-    lastSnapshotTime = lastUpdateTime;
+    lastMetricsTime = lastUpdateTime;
     
     std::cout << "GameServer initialized:" << std::endl;
     std::cout << "  Port: " << config.port << std::endl;
     std::cout << "  Tick Rate: " << config.tickRate << " Hz" << std::endl;
-    std::cout << "  Snapshot Rate: " << config.snapshotRate << " Hz" << std::endl;
+    std::cout << "  Snapshot Rate: " << config.snapshotRate << " Hz (adaptive "
+              << config.snapshotRateMin << "-" << config.snapshotRateMax << " Hz)" << std::endl;
     std::cout << "  Max Players: " << config.maxPlayers << std::endl;
     
     return true;
@@ -97,14 +127,77 @@ void GameServer::run() {
             accumulator -= fixedDelta;
         }
         
-        // Send snapshots (at snapshot rate)
-        auto snapshotElapsed = std::chrono::duration<float>(
-            currentTime - lastSnapshotTime
-        ).count();
+        // Send snapshots to clients that are due (each at its own rate)
+        sendSnapshots();
+        
+        // Messages that didn't ride in a snapshot, and resends
+        networkManager.flushMessages();
         
-        if (snapshotElapsed >= config.snapshotInterval()) {
-            sendSnapshots();
-            lastSnapshotTime = currentTime;
+        if (config.metricsInterval > 0.0f &&
+            std::chrono::duration<float>(currentTime - lastMetricsTime).count() >= config.metricsInterval) {
+            NetworkThread::Stats ioStats;
+            if (networkManager.getNetworkStats(ioStats)) {
+                metrics.datagramsReceived = ioStats.received;
+                metrics.datagramsSent = ioStats.sent;
+                metrics.inboundDropped = ioStats.inboundDropped;
+                metrics.outboundDropped = ioStats.outboundDropped;
+                metrics.socketSyscalls = ioStats.syscalls;
+                metrics.datagramsTruncated = ioStats.truncated;
+            }
+            const game::network::PacketPool::Stats& poolStats = game::network::PacketPool::local().getStats();
+            metrics.packetHeapAllocations = poolStats.heapAllocations;
+            metrics.packetBuffersInUse = poolStats.inUse;
+            metrics.packetBuffersPeak = poolStats.peakInUse;
+            const InputJitterBuffer::Stats inputStats = networkManager.getInputStats();
+            metrics.inputsReceived = inputStats.received;
+            metrics.inputsDuplicate = inputStats.duplicates;
+            metrics.inputsLate = inputStats.late;
+            metrics.inputsStarved = inputStats.starved;
+            metrics.inputsIdle = inputStats.idle;
+            metrics.inputsSkipped = inputStats.skipped;
+            const game::network::ReliableEndpoint::Stats reliableStats = networkManager.getReliableStats();
+            metrics.reliableSent = reliableStats.reliableSent;
+            metrics.reliableResent = reliableStats.reliableResent;
+            metrics.packetsAcked = reliableStats.packetsAcked;
+            metrics.packetsLost = reliableStats.packetsLost;
+            const ShotQueue::Stats shotStats = networkManager.getShotStats();
+            metrics.shotsFired = shotStats.fired;
+            metrics.shotsRejectedFull = shotStats.rejectedFull;
+            metrics.shotsRejectedStale = shotStats.rejectedStale;
+            metrics.shotsRejectedCooldown = shotStats.rejectedCooldown;
+            const ConnectionGate::Stats& handshakeStats = networkManager.getHandshakeStats();
+            metrics.challengesSent = handshakeStats.challengesSent;
+            metrics.cookiesRejected = handshakeStats.cookiesRejected;
+            metrics.connectsRateLimited = handshakeStats.rateLimited;
+            metrics.connectsRejectedFull = handshakeStats.rejectedFull;
+            const game::core::StorageMemoryUsage componentMemory = world.getComponentMemoryUsage();
+            metrics.componentMemoryBytes = componentMemory.total;
+            metrics.componentTopType = "-";
+            metrics.componentTopTypeBytes = 0;
+            world.forEachComponentMemoryUsage([&](game::ComponentTypeID, const char* name, size_t bytes) {
+                if (bytes > metrics.componentTopTypeBytes) {
+                    metrics.componentTopType = name;
+                    metrics.componentTopTypeBytes = bytes;
+                }
+            });
+            float rttSum = 0.0f;
+            int rateSum = 0;
+            metrics.snapshotRateMin = 0;
+            metrics.snapshotRateMax = 0;
+            metrics.congestedClients = 0;
+            for (const ClientConnection& conn : networkManager.getConnections()) {
+                rttSum += conn.reliable.getTimeSync().getRtt();
+                const int rate = conn.congestion.getSnapshotRate();
+                rateSum += rate;
+                metrics.snapshotRateMin = rateSum == rate ? rate : std::min(metrics.snapshotRateMin, rate);
+                metrics.snapshotRateMax = std::max(metrics.snapshotRateMax, rate);
+                metrics.congestedClients += conn.congestion.isCongested() ? 1 : 0;
+            }
+            const size_t clientCount = networkManager.getClientCount();
+            metrics.averageRttMs = clientCount > 0 ? rttSum * 1000.0f / static_cast<float>(clientCount) : 0.0f;
+            metrics.snapshotRateAverage = clientCount > 0 ? static_cast<float>(rateSum) / static_cast<float>(clientCount) : 0.0f;
+            metrics.print(std::cout);
+            lastMetricsTime = currentTime;
         }
         
         
@@ -121,41 +214,11 @@ void GameServer::processNetwork() {
     // Process incoming packets
     networkManager.processPackets();
     
-    // CRITICAL: Process INPUT packets from clients
-    // Each client's INPUT should ONLY affect their own entity
-    // IMPORTANT: If no INPUT is received, set velocity to zero (stop movement)
-    for (const auto& [addr, conn] : networkManager.getConnections()) {
-        if (conn.connected && conn.entity.isValid()) {
-            auto input = networkManager.getLastInput(addr);
-            auto* velComp = world.getComponent<game::core::components::VelocityComponent>(conn.entity.id);
-            
-            if (input.valid) {
-                // Read input data from packet
-                game::network::Packet& packet = input.packet;
-                packet.resetRead();  // Skip header
-                
-                float velX = 0, velY = 0;
-                if (packet.read(velX) && packet.read(velY)) {
-                    if (velComp) {
-                        velComp->velocity.x = velX;
-                        velComp->velocity.y = velY;
-                    }
-                }
-            } else {
-                // No INPUT received - stop movement for this entity
-                if (velComp) {
-                    velComp->velocity.x = 0.0f;
-                    velComp->velocity.y = 0.0f;
-                }
-            }
-        }
-    }
-    
     // Check for connection timeouts
     networkManager.checkTimeouts(config.connectionTimeout);
     
     // Check for dead players (health <= 0) and respawn them
-    for (const auto& [addr, conn] : networkManager.getConnections()) {
+    for (const ClientConnection& conn : networkManager.getConnections()) {
         if (conn.connected && conn.entity.isValid()) {
             auto* healthComp = world.getComponent<game::core::components::HealthComponent>(conn.entity.id);
             if (healthComp && healthComp->isDead()) {
@@ -172,32 +235,137 @@ void GameServer::processNetwork() {
     
     // CRITICAL: Handle new connections and spawn entities
     // Each client gets its own unique entity
-    for (const auto& [addr, conn] : networkManager.getConnections()) {
+    ConnectionTable& connections = networkManager.getConnections();
+    for (ConnectionTable::Slot slot : connections.getActiveSlots()) {
+        ClientConnection& conn = connections[slot];
         if (conn.connected && !conn.entity.isValid()) {
             // New client, spawn entity at random safe position (ignore initial position from client)
-            game::core::Entity entity = spawnPlayer(addr, sf::Vector2f(0, 0));  // initialPosition ignored
-            
-            networkManager.setClientEntity(addr, entity);
-            networkManager.sendConnectAck(addr, entity.id);
+            conn.entity = spawnPlayer(conn.address, sf::Vector2f(0, 0));  // initialPosition ignored
+            networkManager.sendConnectAck(slot, conn.entity, mapSize);
         }
     }
 }
 
 void GameServer::updateGame(float deltaTime) {
+    // CRITICAL: Each client's INPUT should ONLY affect their own entity
+    // Exactly one buffered command per client per fixed step
+    for (ClientConnection& conn : networkManager.getConnections()) {
+        if (!conn.connected || !conn.entity.isValid()) {
+            continue;
+        }
+        auto* velComp = world.getComponent<game::core::components::VelocityComponent>(conn.entity.id);
+        if (!velComp) {
+            continue;
+        }
+        
+        game::network::InputCommand command;
+        if (conn.inputBuffer.consume(command)) {
+            velComp->velocity = command.velocity;
+        } else {
+            velComp->velocity = sf::Vector2f(0.0f, 0.0f);  // No input yet
+        }
+    }
+    
     // Update ECS world
     world.update(deltaTime);
+    
+    // Remember where players ended this tick for rewound hit tests
+    lagCompensation.record(++serverTick, world);
 }
 
 void GameServer::sendSnapshots() {
-    if (networkManager.getClientCount() == 0) {
-        return;  // No clients to send to
+    // Each client has its own rate; build the world state only if one is due
+    const auto now = std::chrono::steady_clock::now();
+    bool anyDue = false;
+    for (const ClientConnection& conn : networkManager.getConnections()) {
+        if (conn.connected && conn.entity.isValid() && now >= conn.nextSnapshotTime) {
+            anyDue = true;
+            break;
+        }
+    }
+    if (!anyDue) {
+        return;
     }
     
-    game::network::Packet packet(game::network::PacketType::SNAPSHOT);
-    createSnapshotPacket(packet);
+    // Capture world state once and index it spatially
+    worldSnapshot.sequence = ++snapshotSequence;
+    createSnapshot(worldSnapshot);
     
-    // Broadcast to all clients
-    networkManager.broadcastPacket(packet);
+    interestGrid.clear();
+    for (size_t i = 0; i < worldSnapshot.entities.size(); ++i) {
+        interestGrid.insert(static_cast<uint32_t>(i), worldSnapshot.entities[i].position);
+    }
+    interestGrid.build();
+    
+    // Each client gets only the entities around its player, delta-encoded
+    // against the last snapshot that client acknowledged and trimmed to
+    // its byte budget by priority
+    ConnectionTable& connections = networkManager.getConnections();
+    for (ConnectionTable::Slot slot : connections.getActiveSlots()) {
+        ClientConnection& conn = connections[slot];
+        if (!conn.connected || !conn.entity.isValid() || now < conn.nextSnapshotTime) {
+            continue;
+        }
+        
+        // Adapt rate and budget to this client's loss and RTT, then schedule
+        // the next one (restart the schedule after a stall instead of bursting)
+        if (conn.congestion.update(conn.reliable.getStats(), conn.reliable.getTimeSync(), now)) {
+            ++metrics.snapshotRateChanges;
+        }
+        const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(conn.congestion.getSnapshotInterval()));
+        conn.nextSnapshotTime += interval;
+        if (conn.nextSnapshotTime <= now) {
+            conn.nextSnapshotTime = now + interval;
+        }
+        
+        createClientSnapshot(conn.entity.id, clientSnapshot);
+        clientSnapshot.tick = serverTick;
+        clientSnapshot.inputAck = conn.inputBuffer.getLastConsumedTick();  // For client reconciliation
+        
+        const game::network::Snapshot* baseline = conn.snapshots.find(conn.lastAckedSnapshot);
+        
+        // Keep the most important changes within this client's budget
+        const int budget = conn.congestion.getSnapshotByteBudget();
+        metrics.entityUpdatesDeferred += conn.priorities.select(
+            clientSnapshot, clientGains, baseline, conn.entity.id,
+            static_cast<size_t>(budget), snapshotSpec);
+        
+        game::network::BitWriter writer(snapshotBuffer.data(), snapshotBuffer.size());
+        game::network::SnapshotCodec::writeDelta(writer, clientSnapshot, baseline, snapshotSpec);
+        
+        if (writer.hasOverflowed()) {
+            // Don't record a state the client can never decode; it keeps
+            // its old baseline and gets a smaller delta next time
+            std::cerr << "WARNING: Snapshot " << clientSnapshot.sequence << " for "
+                      << conn.address.toString() << " exceeds " << game::network::MAX_FRAGMENTED_SIZE
+                      << " bytes, skipped" << std::endl;
+            ++metrics.snapshotsSkipped;
+            continue;
+        }
+        
+        const size_t payloadSize = writer.getBytesWritten();
+        if (payloadSize + sizeof(uint8_t) <= game::network::MAX_PAYLOAD_SIZE) {
+            // Queued messages share the datagram (whatever fits next to the snapshot)
+            game::network::Packet packet(game::network::PacketType::SNAPSHOT);
+            conn.reliable.writeMessages(packet, std::chrono::steady_clock::now(), payloadSize);
+            packet.writeBytes(snapshotBuffer.data(), payloadSize);
+            networkManager.sendPacket(slot, packet);
+        } else {
+            // Larger than one MTU: split, the client reassembles by snapshot ID
+            const size_t fragments = game::network::sendFragmented(
+                clientSnapshot.sequence, snapshotBuffer.data(), payloadSize,
+                [&](game::network::Packet& fragment) {
+                    networkManager.sendPacket(slot, fragment);
+                });
+            ++metrics.snapshotsFragmented;
+            metrics.fragmentsSent += fragments;
+        }
+        ++metrics.snapshotsSent;
+        metrics.snapshotBytesSent += payloadSize;
+        
+        conn.snapshots.insert(clientSnapshot.sequence).entities = clientSnapshot.entities;
+    }
 }
 
 game::core::Entity GameServer::spawnPlayer(const game::network::Address& address, const sf::Vector2f& initialPosition) {
@@ -229,58 +397,100 @@ game::core::Entity GameServer::spawnPlayer(const game::network::Address& address
     return entity;
 }
 
-void GameServer::createSnapshotPacket(game::network::Packet& packet) {
-    // Get all entities with Position + Sprite components
-    auto entities = world.getEntitiesWith<
-        game::core::components::PositionComponent,
-        game::core::components::SpriteComponent
-    >();
-    
-    // Write entity count
-    uint32_t entityCount = static_cast<uint32_t>(entities.size());
-    packet.write(entityCount);
-    
-    // Write each entity
-    for (game::core::Entity::ID entityID : entities) {
-        // Write entity ID
-        packet.write(entityID);
-        
-        // Write PositionComponent
-        const auto* pos = world.getComponent<game::core::components::PositionComponent>(entityID);
-        if (pos) {
-            packet.write(pos->position.x);
-            packet.write(pos->position.y);
-        }
+void GameServer::createSnapshot(game::network::Snapshot& snapshot) {
+    snapshot.entities.clear();
+    
+    // All entities with Position + Sprite components
+    for (auto [entityID, pos, sprite] : world.view<
+             const game::core::components::PositionComponent,
+             const game::core::components::SpriteComponent>()) {
+        game::network::EntityState state;
+        state.id = entityID;
+        state.generation = world.getEntity(entityID).generation;
+        state.position = pos.position;
+        state.size = sprite.size;
+        state.color = sprite.color.toInteger();
         
-        // Write SpriteComponent (size and color)
-        const auto* sprite = world.getComponent<game::core::components::SpriteComponent>(entityID);
-        if (sprite) {
-            packet.write(sprite->size.x);
-            packet.write(sprite->size.y);
-            packet.write(sprite->color.r);
-            packet.write(sprite->color.g);
-            packet.write(sprite->color.b);
-            packet.write(sprite->color.a);
-        }
-        
-        // Write HealthComponent (if exists)
         const auto* health = world.getComponent<game::core::components::HealthComponent>(entityID);
         if (health) {
-            packet.write(static_cast<uint8_t>(1));  // Has health component flag
-            packet.write(health->currentHealth);
-            packet.write(health->maxHealth);
-        } else {
-            packet.write(static_cast<uint8_t>(0));  // No health component
+            state.hasHealth = true;
+            state.health = health->currentHealth;
+            state.maxHealth = health->maxHealth;
         }
         
-        // Write KillCounterComponent (if exists)
         const auto* killCounter = world.getComponent<game::core::components::KillCounterComponent>(entityID);
         if (killCounter) {
-            packet.write(static_cast<uint8_t>(1));  // Has kill counter flag
-            packet.write(static_cast<int32_t>(killCounter->getKills()));
-        } else {
-            packet.write(static_cast<uint8_t>(0));  // No kill counter
+            state.hasKillCounter = true;
+            state.killCount = static_cast<int32_t>(killCounter->getKills());
         }
+        
+        // Diff on the values the client will actually decode
+        game::network::SnapshotCodec::quantize(state, snapshotSpec);
+        snapshot.entities.push_back(state);
+    }
+    
+    snapshot.sortEntities();
+    
+    // Players matter most, projectiles are short-lived and cheap to miss
+    entityWeights.clear();
+    for (const game::network::EntityState& state : snapshot.entities) {
+        float weight = config.priorityDefaultWeight;
+        if (state.hasKillCounter) {
+            weight = config.priorityPlayerWeight;
+        } else if (world.hasComponent<game::core::components::ProjectileComponent>(state.id)) {
+            weight = config.priorityProjectileWeight;
+        }
+        entityWeights.push_back(weight);
+    }
+}
+
+void GameServer::createClientSnapshot(game::core::Entity::ID viewer, game::network::Snapshot& snapshot) {
+    snapshot.sequence = worldSnapshot.sequence;
+    snapshot.entities.clear();
+    clientGains.clear();
+    
+    const game::network::EntityState* self = worldSnapshot.find(viewer);
+    if (!self) {
+        return;  // Viewer has no position yet, nothing is relevant
+    }
+    
+    const sf::Vector2f center = self->position;
+    const sf::FloatRect area(
+        center.x - config.interestHalfWidth,
+        center.y - config.interestHalfHeight,
+        config.interestHalfWidth * 2.0f,
+        config.interestHalfHeight * 2.0f
+    );
+    const float radiusSquared = config.interestRadius * config.interestRadius;
+    
+    visibleIndices.clear();
+    interestGrid.query(area, [&](uint32_t index, const sf::Vector2f& position) {
+        if (config.interestRadius > 0.0f) {
+            const sf::Vector2f delta = position - center;
+            if (delta.x * delta.x + delta.y * delta.y > radiusSquared) {
+                return;
+            }
+        }
+        visibleIndices.push_back(index);
+    });
+    
+    // Always relevant: the viewer itself (even if filtered out by the radius)
+    const uint32_t selfIndex = static_cast<uint32_t>(self - worldSnapshot.entities.data());
+    if (std::find(visibleIndices.begin(), visibleIndices.end(), selfIndex) == visibleIndices.end()) {
+        visibleIndices.push_back(selfIndex);
+    }
+    
+    // worldSnapshot is sorted by ID, so sorted indices keep the output sorted
+    std::sort(visibleIndices.begin(), visibleIndices.end());
+    for (uint32_t index : visibleIndices) {
+        const game::network::EntityState& state = worldSnapshot.entities[index];
+        snapshot.entities.push_back(state);
+        
+        // Closer entities gain priority faster
+        const sf::Vector2f delta = state.position - center;
+        const float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+        clientGains.push_back(entityWeights[index] * config.priorityDistanceScale /
+                              (config.priorityDistanceScale + distance));
     }
 }
 
@@ -296,6 +506,7 @@ void GameServer::loadColliders() {
         // Get the world and level
         auto& world = project.getWorld();
         auto& level0 = world.getLevel("World_Level_0");
+        mapSize = sf::Vector2f(static_cast<float>(level0.size.x), static_cast<float>(level0.size.y));
         
         // Load colliders from IntGrid "Collisions" layer
         auto& collisions_layer = level0.getLayer("Collisions");
@@ -4,6 +4,10 @@
 #include <memory>
 #include "ServerConfig.hpp"
 #include "ServerNetworkManager.hpp"
+#include "SpatialGrid.hpp"
+#include "LagCompensation.hpp"
+#include "ServerMetrics.hpp"
+#include "../network/Snapshot.hpp"
 #include "../core/World.hpp"
 #include "../core/components/PositionComponent.hpp"
 #include "../core/components/VelocityComponent.hpp"
@@ -62,6 +66,11 @@ public:
      */
     const ServerConfig& getConfig() const { return config; }
     
+    /**
+     * Get server metrics
+     */
+    const ServerMetrics& getMetrics() const { return metrics; }
+    
     /**
      * Get ECS World
      */
@@ -75,12 +84,32 @@ private:
     
     // Collision data
     std::vector<sf::FloatRect> colliders;  // Static colliders (walls, obstacles)
+    sf::Vector2f mapSize = {4096.0f, 4096.0f};  // Level size in pixels (from LDtk)
     
     bool running;
     std::chrono::steady_clock::time_point lastUpdateTime;
-    std::chrono::steady_clock::time_point lastSnapshotTime;
+    std::chrono::steady_clock::time_point lastMetricsTime;
     float accumulator;  // For fixed timestep
     
+    // Simulation tick (stamped on snapshots, used to rewind shots)
+    uint32_t serverTick = 0;
+    LagCompensation lagCompensation;
+    
+    // Snapshot state
+    uint32_t snapshotSequence = 0;
+    game::network::SnapshotSpec snapshotSpec;  // Quantization, built from mapSize
+    std::vector<uint8_t> snapshotBuffer;       // Encode scratch, up to MAX_FRAGMENTED_SIZE
+    game::network::Snapshot worldSnapshot;  // Reused every snapshot tick
+    game::network::Snapshot clientSnapshot; // Per-client filtered view (reused)
+    std::vector<float> entityWeights;       // Priority weight by type, parallel to worldSnapshot
+    std::vector<float> clientGains;         // Priority gain, parallel to clientSnapshot
+    
+    ServerMetrics metrics;
+    
+    // Interest management
+    SpatialGrid interestGrid;               // Indices into worldSnapshot.entities
+    std::vector<uint32_t> visibleIndices;   // Scratch for per-client queries
+    
     /**
      * Process network packets
      */
@@ -116,9 +145,17 @@ private:
     sf::Vector2f findSafeSpawnPosition();
     
     /**
-     * Create snapshot packet from world state
+     * Capture world state into a snapshot (entities sorted by ID)
+     * Also fills entityWeights for the captured entities.
+     */
+    void createSnapshot(game::network::Snapshot& snapshot);
+    
+    /**
+     * Select the entities relevant to one client (area of interest)
+     * @param viewer Client's player entity (always included)
+     * @param snapshot Output, filtered copy of worldSnapshot (clientGains filled alongside)
      */
-    void createSnapshotPacket(game::network::Packet& packet);
+    void createClientSnapshot(game::core::Entity::ID viewer, game::network::Snapshot& snapshot);
     
     /**
      * Load colliders (for future LDtk integration)
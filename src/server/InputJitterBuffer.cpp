@@ -0,0 +1,119 @@
+#include "InputJitterBuffer.hpp"
+
+namespace game::server {
+
+InputJitterBuffer::InputJitterBuffer(uint32_t targetDelay, uint32_t maxHoldTicks)
+    : targetDelay(targetDelay > 0 ? targetDelay : 1)
+    , maxHoldTicks(maxHoldTicks) {
+}
+
+void InputJitterBuffer::add(const game::network::InputCommand& command) {
+    if (!started) {
+        started = true;
+        nextTick = command.tick;
+        newestTick = command.tick;
+    }
+
+    if (command.tick < nextTick) {
+        // Redundant copies of consumed ticks are expected; only count
+        // ticks that were never seen in time
+        if (nextTick - command.tick <= game::network::MAX_INPUTS_PER_PACKET &&
+            slotFor(command.tick).command.tick == command.tick) {
+            ++stats.duplicates;
+        } else {
+            ++stats.late;
+        }
+        return;
+    }
+
+    if (command.tick - nextTick >= CAPACITY) {
+        // Far ahead (client clock jumped or server stalled): start over
+        for (Slot& slot : slots) {
+            slot.valid = false;
+        }
+        stats.skipped += buffered;
+        buffered = 0;
+        nextTick = command.tick;
+        consuming = false;
+    }
+
+    Slot& slot = slotFor(command.tick);
+    if (slot.valid && slot.command.tick == command.tick) {
+        ++stats.duplicates;
+        return;
+    }
+
+    slot.command = command;
+    slot.valid = true;
+    ++buffered;
+    ++stats.received;
+    if (command.tick > newestTick) {
+        newestTick = command.tick;
+    }
+}
+
+bool InputJitterBuffer::consume(game::network::InputCommand& out) {
+    if (!started) {
+        return false;
+    }
+    if (!consuming) {
+        if (buffered < targetDelay) {
+            return false;
+        }
+        consuming = true;
+    }
+
+    // Client ran ahead (e.g. server hitch): drop one step per tick until
+    // the depth is back near the target
+    if (buffered > targetDelay * 2 + 2) {
+        skipOldest();
+    }
+
+    Slot& slot = slotFor(nextTick);
+    if (slot.valid && slot.command.tick == nextTick) {
+        out = slot.command;
+        slot.valid = false;
+        --buffered;
+        ++nextTick;
+        lastCommand = out;
+        lastConsumedTick = out.tick;
+        holdTicks = 0;
+        return true;
+    }
+
+    // A quiet client (nothing buffered, hold used up) isn't starvation
+    if (buffered > 0 || holdTicks < maxHoldTicks) {
+        ++stats.starved;
+    } else {
+        ++stats.idle;
+    }
+    if (buffered > 0) {
+        ++nextTick;  // This tick is lost; later ones are already here
+    }
+    // Otherwise keep waiting on nextTick: the buffer grows by one step
+
+    out = lastCommand;
+    out.tick = nextTick - 1;
+    if (holdTicks >= maxHoldTicks) {
+        out.velocity = sf::Vector2f(0.0f, 0.0f);  // Client went quiet, stop
+    } else {
+        ++holdTicks;
+    }
+    return true;
+}
+
+void InputJitterBuffer::skipOldest() {
+    while (buffered > 0) {
+        Slot& slot = slotFor(nextTick);
+        const bool present = slot.valid && slot.command.tick == nextTick;
+        ++nextTick;
+        if (present) {
+            slot.valid = false;
+            --buffered;
+            ++stats.skipped;
+            return;
+        }
+    }
+}
+
+} // namespace game::server
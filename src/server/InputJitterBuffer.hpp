@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "../network/InputCommand.hpp"
+
+namespace game::server {
+
+/**
+ * Input Jitter Buffer
+ *
+ * Per-client queue of input commands keyed by client tick. The game loop
+ * consumes exactly one command per fixed step, so packets that arrive in
+ * bursts, out of order or twice still drive one movement step each.
+ *
+ * Consumption starts once targetDelay commands are buffered. If the next
+ * tick is missing, the last command is held for a few ticks (a lost
+ * command usually arrives again in the next packet's redundant copies).
+ * If the buffer runs deeper than needed, old commands are skipped so the
+ * added latency stays bounded.
+ */
+class InputJitterBuffer {
+public:
+    static constexpr size_t CAPACITY = 64;  // Ticks (~1 s at 60 Hz)
+
+    struct Stats {
+        uint64_t received = 0;    // Unique commands accepted
+        uint64_t duplicates = 0;  // Already buffered (redundant copies)
+        uint64_t late = 0;        // Arrived after their tick was consumed or skipped
+        uint64_t starved = 0;     // Steps with no command for the tick (held or lost)
+        uint64_t idle = 0;        // Steps with nothing buffered after the hold ran out (client quiet)
+        uint64_t skipped = 0;     // Dropped to bring latency back down
+
+        Stats& operator+=(const Stats& other) {
+            received += other.received;
+            duplicates += other.duplicates;
+            late += other.late;
+            starved += other.starved;
+            idle += other.idle;
+            skipped += other.skipped;
+            return *this;
+        }
+    };
+
+    /**
+     * @param targetDelay Commands buffered before consumption starts
+     * @param maxHoldTicks Steps the last command is repeated while starved
+     */
+    explicit InputJitterBuffer(uint32_t targetDelay = 2, uint32_t maxHoldTicks = 6);
+
+    /**
+     * Add a received command (duplicates and late commands are ignored)
+     */
+    void add(const game::network::InputCommand& command);
+
+    /**
+     * Command for this fixed step (held or zero velocity when starved)
+     * @return False if nothing was buffered yet (still filling)
+     */
+    bool consume(game::network::InputCommand& out);
+
+    /**
+     * Tick of the newest command actually consumed (0 = none); held or
+     * zero commands during starvation don't count
+     */
+    uint32_t getLastConsumedTick() const { return lastConsumedTick; }
+    
+    /**
+     * Buffered commands not consumed yet
+     */
+    size_t size() const { return buffered; }
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Slot {
+        game::network::InputCommand command;
+        bool valid = false;
+    };
+
+    std::array<Slot, CAPACITY> slots;
+    uint32_t targetDelay;
+    uint32_t maxHoldTicks;
+
+    bool started = false;           // First command seen
+    bool consuming = false;         // Filled to targetDelay at least once
+    uint32_t nextTick = 0;          // Next tick to consume
+    uint32_t newestTick = 0;
+    size_t buffered = 0;
+    uint32_t holdTicks = 0;
+    uint32_t lastConsumedTick = 0;
+    game::network::InputCommand lastCommand;
+    Stats stats;
+
+    Slot& slotFor(uint32_t tick) { return slots[tick % CAPACITY]; }
+    void skipOldest();
+};
+
+} // namespace game::server
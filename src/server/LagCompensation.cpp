@@ -0,0 +1,80 @@
+#include "LagCompensation.hpp"
+#include "CollisionHelper.hpp"
+#include "../core/World.hpp"
+#include "../core/components/PositionComponent.hpp"
+#include "../core/components/SpriteComponent.hpp"
+#include "../core/components/HealthComponent.hpp"
+#include <algorithm>
+
+namespace game::server {
+
+void LagCompensation::configure(size_t historyTicks, size_t maxEntityCount) {
+    frames.assign(std::max<size_t>(historyTicks, 1), Frame());
+    maxEntities = maxEntityCount;
+    for (Frame& frame : frames) {
+        frame.records.reserve(maxEntities);
+    }
+    newestTick = 0;
+}
+
+void LagCompensation::record(uint32_t tick, const game::core::World& world) {
+    if (frames.empty()) {
+        return;
+    }
+    
+    Frame& frame = frames[tick % frames.size()];
+    frame.tick = tick;
+    frame.records.clear();
+    
+    for (auto [entity, health, position, sprite] : world.view<
+             game::core::components::HealthComponent,
+             game::core::components::PositionComponent,
+             game::core::components::SpriteComponent>()) {
+        if (frame.records.size() >= maxEntities) {
+            break;
+        }
+        frame.records.push_back({entity, CollisionHelper::getPlayerCollider(position.position, sprite.size)});
+    }
+    std::sort(frame.records.begin(), frame.records.end(),
+              [](const Record& a, const Record& b) { return a.entity < b.entity; });
+    
+    newestTick = tick;
+}
+
+uint32_t LagCompensation::rewindTicksFor(uint32_t viewTick) const {
+    if (viewTick == 0 || viewTick >= newestTick) {
+        return 0;
+    }
+    const uint32_t maxRewind = static_cast<uint32_t>(frames.size() - 1);
+    return std::min(newestTick - viewTick, std::min(maxRewind, newestTick - 1));
+}
+
+bool LagCompensation::getCollider(game::EntityID entity, uint32_t ticksAgo, sf::FloatRect& out) const {
+    if (frames.empty() || ticksAgo >= frames.size() || ticksAgo >= newestTick) {
+        return false;
+    }
+    
+    const uint32_t tick = newestTick - ticksAgo;
+    const Frame& frame = frames[tick % frames.size()];
+    if (frame.tick != tick) {
+        return false;
+    }
+    
+    auto it = std::lower_bound(frame.records.begin(), frame.records.end(), entity,
+                               [](const Record& record, game::EntityID id) { return record.entity < id; });
+    if (it == frame.records.end() || it->entity != entity) {
+        return false;
+    }
+    out = it->collider;
+    return true;
+}
+
+void LagCompensation::clear() {
+    for (Frame& frame : frames) {
+        frame.tick = 0;
+        frame.records.clear();
+    }
+    newestTick = 0;
+}
+
+} // namespace game::server
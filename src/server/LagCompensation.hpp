@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <SFML/Graphics/Rect.hpp>
+#include "../core/Entity.hpp"
+
+namespace game::core {
+    class World;
+}
+
+namespace game::server {
+
+/**
+ * Lag Compensation
+ *
+ * Bounded history of player colliders, one frame per simulation tick,
+ * so shots can be resolved against where targets were on the shooter's
+ * screen. A client sees remote players roughly RTT/2 plus its
+ * interpolation delay in the past; it sends that view tick with SHOOT
+ * and the projectile is tested against the colliders of that tick.
+ *
+ * All frames are allocated up front (history length x max players);
+ * recording never allocates.
+ */
+class LagCompensation {
+public:
+    LagCompensation() = default;
+
+    /**
+     * Preallocate the history
+     * @param historyTicks Number of ticks that can be rewound
+     * @param maxEntities Players recorded per tick (extra ones are not rewound)
+     */
+    void configure(size_t historyTicks, size_t maxEntities);
+
+    /**
+     * Record the colliders of every player (Position + Sprite + Health)
+     * at the end of a tick
+     */
+    void record(uint32_t tick, const game::core::World& world);
+
+    /**
+     * Newest recorded tick (0 = nothing recorded)
+     */
+    uint32_t getNewestTick() const { return newestTick; }
+
+    /**
+     * Ticks between a client's view tick and the newest recorded tick,
+     * clamped to the available history (0 = no rewind)
+     */
+    uint32_t rewindTicksFor(uint32_t viewTick) const;
+
+    /**
+     * Collider of an entity a number of ticks before the newest frame
+     * @return False if the entity wasn't recorded then (use its current collider)
+     */
+    bool getCollider(game::EntityID entity, uint32_t ticksAgo, sf::FloatRect& out) const;
+
+    /**
+     * Forget everything (keeps the allocation)
+     */
+    void clear();
+
+private:
+    struct Record {
+        game::EntityID entity;
+        sf::FloatRect collider;
+    };
+
+    struct Frame {
+        uint32_t tick = 0;  // 0 = empty
+        std::vector<Record> records;  // Sorted by entity ID
+    };
+
+    std::vector<Frame> frames;  // Ring indexed by tick % size
+    size_t maxEntities = 0;
+    uint32_t newestTick = 0;
+};
+
+} // namespace game::server
@@ -0,0 +1,144 @@
+#include "NetworkThread.hpp"
+#include <SFML/System/Time.hpp>
+
+namespace game::server {
+
+NetworkThread::~NetworkThread() {
+    stop();
+}
+
+bool NetworkThread::start(game::network::DatagramSocket& datagramSocket) {
+    if (isRunning()) {
+        return false;
+    }
+
+    socket = &datagramSocket;
+    running.store(true, std::memory_order_release);
+    thread = std::thread(&NetworkThread::run, this);
+    return true;
+}
+
+void NetworkThread::stop() {
+    if (!running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (thread.joinable()) {
+        thread.join();
+    }
+    socket = nullptr;
+}
+
+bool NetworkThread::send(const game::network::Address& address, const uint8_t* data, size_t size) {
+    game::network::Datagram* slot = outboundQueue.prepare();
+    if (!slot) {
+        outboundDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (!slot->assign(address, data, size)) {
+        return false;  // Larger than MAX_PACKET_SIZE, slot stays unpublished
+    }
+    outboundQueue.commit();
+    return true;
+}
+
+NetworkThread::Stats NetworkThread::getStats() const {
+    Stats stats;
+    stats.received = receivedCount.load(std::memory_order_relaxed);
+    stats.sent = sentCount.load(std::memory_order_relaxed);
+    stats.inboundDropped = inboundDropped.load(std::memory_order_relaxed);
+    stats.outboundDropped = outboundDropped.load(std::memory_order_relaxed);
+    stats.syscalls = syscallCount.load(std::memory_order_relaxed);
+    stats.truncated = truncatedCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void NetworkThread::run() {
+    // Short wait so queued sends go out promptly even when nothing arrives
+    const sf::Time idleWait = sf::microseconds(500);
+
+    while (running.load(std::memory_order_acquire)) {
+        const size_t work = flushOutbound() + drainSocket();
+        syscallCount.store(socket->getSyscallCount(), std::memory_order_relaxed);
+        truncatedCount.store(socket->getTruncatedCount(), std::memory_order_relaxed);
+        if (work == 0) {
+            socket->waitReadable(idleWait);
+        }
+    }
+
+    // Don't lose e.g. DISCONNECT replies queued right before shutdown
+    flushOutbound();
+}
+
+size_t NetworkThread::flushOutbound() {
+    const game::network::Datagram* batch[game::network::DatagramSocket::MAX_BATCH];
+    size_t total = 0;
+
+    while (size_t pending = outboundQueue.readable()) {
+        const size_t count = std::min(pending, game::network::DatagramSocket::MAX_BATCH);
+        for (size_t i = 0; i < count; ++i) {
+            batch[i] = outboundQueue.front(i);
+        }
+
+        const size_t sent = socket->sendBatch(batch, count);
+        outboundQueue.pop(sent);
+        total += sent;
+        if (sent < count) {
+            break;  // Socket buffer full, rest goes next iteration
+        }
+    }
+
+    if (total > 0) {
+        sentCount.fetch_add(total, std::memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t NetworkThread::drainSocket() {
+    game::network::Datagram* batch[game::network::DatagramSocket::MAX_BATCH];
+    size_t total = 0;
+
+    while (true) {
+        const size_t free = inboundQueue.writable();
+        if (free == 0) {
+            // Simulation is behind: still drain the socket, but drop
+            static thread_local game::network::Datagram overflow[game::network::DatagramSocket::MAX_BATCH];
+            for (size_t i = 0; i < game::network::DatagramSocket::MAX_BATCH; ++i) {
+                batch[i] = &overflow[i];
+            }
+            const size_t dropped = socket->receiveBatch(batch, game::network::DatagramSocket::MAX_BATCH);
+            inboundDropped.fetch_add(dropped, std::memory_order_relaxed);
+            total += dropped;
+            if (dropped < game::network::DatagramSocket::MAX_BATCH) {
+                break;
+            }
+            continue;
+        }
+
+        // Receive straight into queue slots
+        const size_t count = std::min(free, game::network::DatagramSocket::MAX_BATCH);
+        for (size_t i = 0; i < count; ++i) {
+            batch[i] = inboundQueue.prepare(i);
+        }
+        const size_t received = socket->receiveBatch(batch, count);
+        if (received == 0) {
+            break;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < received; ++i) {
+            batch[i]->receivedAt = now;
+        }
+        inboundQueue.commit(received);
+        total += received;
+        if (received < count) {
+            break;  // Socket drained
+        }
+    }
+
+    if (total > 0) {
+        receivedCount.fetch_add(total, std::memory_order_relaxed);
+    }
+    return total;
+}
+
+} // namespace game::server
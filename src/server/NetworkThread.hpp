@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include "../network/Datagram.hpp"
+#include "../network/DatagramSocket.hpp"
+#include "../network/SpscQueue.hpp"
+
+namespace game::server {
+
+/**
+ * Network I/O Thread
+ *
+ * Owns the server socket while running: receives datagrams into the
+ * inbound queue and sends whatever the simulation thread put in the
+ * outbound queue. Receive latency no longer depends on how long a
+ * simulation tick takes, and socket calls leave the simulation thread.
+ *
+ * Threading: the simulation thread is the only consumer of the inbound
+ * queue (receive/release) and the only producer of the outbound one (send).
+ */
+class NetworkThread {
+public:
+    static constexpr size_t QUEUE_SIZE = 1024;  // Datagrams per direction
+    using Queue = game::network::SpscQueue<game::network::Datagram, QUEUE_SIZE>;
+
+    struct Stats {
+        uint64_t received = 0;
+        uint64_t sent = 0;
+        uint64_t inboundDropped = 0;   // Inbound queue full (simulation too slow)
+        uint64_t outboundDropped = 0;  // Outbound queue full (socket too slow)
+        uint64_t syscalls = 0;         // Socket calls (fewer than datagrams when batched)
+        uint64_t truncated = 0;        // Oversized datagrams dropped by the socket
+
+        Stats& operator+=(const Stats& other) {
+            received += other.received;
+            sent += other.sent;
+            inboundDropped += other.inboundDropped;
+            outboundDropped += other.outboundDropped;
+            syscalls += other.syscalls;
+            truncated += other.truncated;
+            return *this;
+        }
+    };
+
+    NetworkThread() = default;
+    ~NetworkThread();
+
+    NetworkThread(const NetworkThread&) = delete;
+    NetworkThread& operator=(const NetworkThread&) = delete;
+
+    /**
+     * Start the thread; socket must be bound and outlive the thread
+     */
+    bool start(game::network::DatagramSocket& socket);
+
+    /**
+     * Stop and join (pending outbound datagrams are flushed first)
+     */
+    void stop();
+
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    /**
+     * Oldest received datagram, or nullptr; call release() when done
+     */
+    game::network::Datagram* receive() { return inboundQueue.front(); }
+    void release() { inboundQueue.pop(); }
+
+    /**
+     * Queue a datagram for sending
+     * @return False if the outbound queue is full (datagram dropped)
+     */
+    bool send(const game::network::Address& address, const uint8_t* data, size_t size);
+
+    Stats getStats() const;
+
+private:
+    game::network::DatagramSocket* socket = nullptr;
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    Queue inboundQueue;
+    Queue outboundQueue;
+
+    std::atomic<uint64_t> receivedCount{0};
+    std::atomic<uint64_t> sentCount{0};
+    std::atomic<uint64_t> inboundDropped{0};
+    std::atomic<uint64_t> outboundDropped{0};
+    std::atomic<uint64_t> syscallCount{0};
+    std::atomic<uint64_t> truncatedCount{0};
+
+    void run();
+    size_t flushOutbound();
+    size_t drainSocket();
+};
+
+} // namespace game::server
@@ -0,0 +1,105 @@
+#include "PriorityAccumulator.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace game::server {
+
+size_t PriorityAccumulator::select(game::network::Snapshot& snapshot, const std::vector<float>& gains,
+                                   const game::network::Snapshot* baseline, game::EntityID mandatory,
+                                   size_t budgetBytes, const game::network::SnapshotSpec& spec) {
+    namespace codec = game::network::SnapshotCodec;
+    static const std::vector<game::network::EntityState> emptyEntities;
+    const auto& base = baseline ? baseline->entities : emptyEntities;
+    auto& states = snapshot.entities;
+
+    merged.clear();
+    candidates.clear();
+
+    // Merge walk over three ID-sorted lists: snapshot, baseline, old priorities
+    size_t b = 0, e = 0, removed = 0;
+    size_t removedBits = 0;
+    for (uint32_t i = 0; i < states.size(); ++i) {
+        const game::network::EntityState& state = states[i];
+        while (b < base.size() && base[b].id < state.id) {
+            removedBits += codec::varUintBits(base[b].id);
+            ++removed;
+            ++b;
+        }
+        while (e < entries.size() && entries[e].id < state.id) ++e;
+
+        float priority = gains[i];
+        if (e < entries.size() && entries[e].id == state.id) {
+            priority += entries[e].priority;
+        }
+
+        const bool inBaseline = b < base.size() && base[b].id == state.id;
+        const uint8_t mask = inBaseline ? codec::diff(state, base[b]) : static_cast<uint8_t>(codec::FIELD_ALL);
+        if (mask == 0) {
+            merged.push_back({state.id, 0.0f});  // Client is up to date
+            ++b;
+            continue;
+        }
+
+        if (state.id == mandatory) {
+            priority = std::numeric_limits<float>::max();
+        }
+
+        Candidate candidate;
+        candidate.index = i;
+        candidate.entry = static_cast<uint32_t>(merged.size());
+        candidate.baseIndex = inBaseline ? static_cast<int32_t>(b) : -1;
+        candidate.priority = priority;
+        // ID gap is at most the ID itself
+        candidate.bits = static_cast<uint32_t>(codec::varUintBits(state.id) + codec::fieldBits(state, mask, spec));
+        candidates.push_back(candidate);
+        merged.push_back({state.id, priority});
+        if (inBaseline) ++b;
+    }
+    for (; b < base.size(); ++b) {
+        removedBits += codec::varUintBits(base[b].id);
+        ++removed;
+    }
+
+    // Fixed cost: sequence, tick, baseline distance, input ack, both counts, removals
+    const size_t headerBits = 64 + codec::varUintBits(baseline ? snapshot.sequence - baseline->sequence : 0) +
+                              codec::varUintBits(snapshot.inputAck) +
+                              codec::varUintBits(static_cast<uint32_t>(candidates.size())) +
+                              codec::varUintBits(static_cast<uint32_t>(removed)) + removedBits;
+    const size_t budgetBits = budgetBytes * 8;
+    size_t usedBits = headerBits;
+
+    std::sort(candidates.begin(), candidates.end(),
+        [](const Candidate& a, const Candidate& c) { return a.priority > c.priority; });
+
+    // Greedy fill; keep scanning after a miss so smaller updates still fit
+    size_t deferred = 0;
+    bool dropped = false;
+    for (const Candidate& candidate : candidates) {
+        const bool isMandatory = states[candidate.index].id == mandatory;
+        if (isMandatory || usedBits + candidate.bits <= budgetBits) {
+            usedBits += candidate.bits;
+            merged[candidate.entry].priority = 0.0f;
+            continue;
+        }
+
+        ++deferred;
+        if (candidate.baseIndex >= 0) {
+            states[candidate.index] = base[candidate.baseIndex];  // Nothing to send
+        } else {
+            states[candidate.index].id = game::INVALID_ENTITY;    // Not sent yet, compacted below
+            dropped = true;
+        }
+    }
+
+    if (dropped) {
+        // Removing entries keeps the remaining ones sorted
+        states.erase(std::remove_if(states.begin(), states.end(),
+            [](const game::network::EntityState& state) { return state.id == game::INVALID_ENTITY; }),
+            states.end());
+    }
+
+    entries.swap(merged);
+    return deferred;
+}
+
+} // namespace game::server
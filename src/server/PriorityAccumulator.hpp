@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "../network/Snapshot.hpp"
+
+namespace game::server {
+
+/**
+ * Priority Accumulator
+ *
+ * Per-client snapshot budgeting. Every visible entity gains priority each
+ * snapshot (the caller supplies the gain, e.g. type and distance weight);
+ * changed entities are then written greedily, highest priority first,
+ * until the byte budget is used up. A written entity drops back to zero,
+ * a skipped one keeps its priority and wins a later snapshot.
+ *
+ * Skipped entities keep their baseline state in the snapshot (nothing is
+ * sent for them) or, if the client has never seen them, are left out.
+ * The trimmed snapshot is therefore exactly what the client will hold.
+ */
+class PriorityAccumulator {
+public:
+    /**
+     * Trim snapshot to fit the budget
+     * @param snapshot Client snapshot, sorted by ID (modified in place)
+     * @param gains Priority gain per entity, parallel to snapshot.entities
+     * @param baseline Snapshot the delta will be written against (nullptr = none)
+     * @param mandatory Entity that is always written (the viewer's player)
+     * @param budgetBytes Upper bound for the encoded delta
+     * @return Number of changed entities deferred to a later snapshot
+     */
+    size_t select(game::network::Snapshot& snapshot, const std::vector<float>& gains,
+                  const game::network::Snapshot* baseline, game::EntityID mandatory,
+                  size_t budgetBytes, const game::network::SnapshotSpec& spec);
+
+    /**
+     * Forget accumulated priorities
+     */
+    void clear() { entries.clear(); }
+
+private:
+    struct Entry {
+        game::EntityID id;
+        float priority;
+    };
+
+    struct Candidate {
+        uint32_t index;      // Into snapshot.entities
+        uint32_t entry;      // Into merged
+        int32_t baseIndex;   // Into baseline entities (-1 = new to the client)
+        float priority;
+        uint32_t bits;
+    };
+
+    std::vector<Entry> entries;   // Visible entities, sorted by ID
+    std::vector<Entry> merged;    // Scratch, swapped with entries
+    std::vector<Candidate> candidates;
+};
+
+} // namespace game::server
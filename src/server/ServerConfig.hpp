@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
+#include <cmath>
 
 namespace game::server {
 
@@ -12,26 +14,67 @@ namespace game::server {
 struct ServerConfig {
     // Network settings
     uint16_t port = 7777;
+    bool networkThread = true;  // Socket I/O on its own thread (false = in the game loop)
+    bool batchedSocketIo = true;  // recvmmsg/sendmmsg on Linux (SFML socket elsewhere)
+    int socketShards = 1;  // > 1: SO_REUSEPORT sockets on the port, one I/O thread each (Linux, batched, network thread)
     
     // Game settings
     int tickRate = 60;  // Ticks per second
     int maxPlayers = 128;
+    bool archetypeStorage = false;  // ECS components in archetype chunks instead of per-type sparse sets
     
-    // Snapshot settings
-    int snapshotRate = 20;  // Snapshots per second (client update rate)
+    // Connection handshake (see ConnectionGate)
+    float connectCookieLifetime = 5.0f;  // Seconds per cookie window
+    float connectRatePerIp = 2.0f;       // CONNECT attempts per second per IP
+    float connectBurstPerIp = 5.0f;      // Attempts allowed at once per IP
+    
+    // Input jitter buffer (per client, in ticks)
+    uint32_t inputBufferDelay = 2;    // Commands buffered before consuming
+    uint32_t inputMaxHoldTicks = 6;   // Repeat last command this long when starved
+    
+    // Snapshot rate (per client, adapted by CongestionController)
+    int snapshotRate = 20;     // Snapshots per second for new clients
+    int snapshotRateMin = 10;  // Floor under congestion
+    int snapshotRateMax = 60;  // Ceiling on good links (also capped by the client and tickRate)
+    int snapshotBandwidth = 48000;  // Snapshot bytes per second per client
+    float congestionLossThreshold = 0.05f;  // Packet loss fraction treated as congestion
+    float congestionRttGrowth = 0.05f;      // Seconds of RTT above the best treated as congestion
+    
+    // Interest management (which entities each client receives)
+    float interestHalfWidth = 260.0f;   // Half camera width (200) + margin
+    float interestHalfHeight = 170.0f;  // Half camera height (125) + margin
+    float interestRadius = 0.0f;        // > 0: also require distance <= radius
+    float interestCellSize = 64.0f;     // Spatial grid cell size (pixels)
+    
+    // Snapshot budget (per client, per snapshot; see PriorityAccumulator)
+    int snapshotByteBudget = 1200;          // Uncongested maximum, CongestionController lowers it
+    float priorityPlayerWeight = 4.0f;      // Priority gained per snapshot, by type
+    float priorityProjectileWeight = 1.0f;
+    float priorityDefaultWeight = 2.0f;
+    float priorityDistanceScale = 128.0f;   // Gain halves at this distance (pixels)
+    
+    // Weapon (per client, see ShotQueue)
+    uint32_t weaponCooldownTicks = 6;  // Ticks between shots (0.1 s at 60 Hz)
+    uint32_t shotToleranceTicks = 2;   // How early a shot may arrive (jitter)
+    
+    // Lag compensation (shots are tested against the shooter's view tick)
+    float lagCompensationWindow = 0.5f;  // seconds of player history kept
     
     // Timeout settings
     float connectionTimeout = 10.0f;  // seconds
     float heartbeatInterval = 1.0f;  // seconds
     
+    // Diagnostics
+    float metricsInterval = 10.0f;  // seconds between metric prints (0 = off)
+    
     // Fixed timestep
     float fixedTimestep() const {
         return 1.0f / static_cast<float>(tickRate);
     }
     
-    // Snapshot interval
-    float snapshotInterval() const {
-        return 1.0f / static_cast<float>(snapshotRate);
+    // Ticks of history for lag compensation
+    size_t lagCompensationTicks() const {
+        return static_cast<size_t>(std::ceil(lagCompensationWindow * static_cast<float>(tickRate))) + 1;
     }
 };
 
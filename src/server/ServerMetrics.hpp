@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+namespace game::server {
+
+/**
+ * Server Metrics
+ *
+ * Counters collected by the server loop and printed periodically
+ * (see ServerConfig::metricsInterval). Counters are cumulative.
+ */
+struct ServerMetrics {
+    // Snapshots
+    uint64_t snapshotsSent = 0;
+    uint64_t snapshotBytesSent = 0;    // Encoded payload bytes (before headers)
+    uint64_t snapshotsSkipped = 0;     // Too large even for fragmentation
+    uint64_t snapshotsFragmented = 0;
+    uint64_t fragmentsSent = 0;
+    uint64_t entityUpdatesDeferred = 0;  // Changed entities left out by the byte budget
+    
+    // Snapshot rates over current connections (CongestionController)
+    int snapshotRateMin = 0;
+    float snapshotRateAverage = 0.0f;
+    int snapshotRateMax = 0;
+    uint32_t congestedClients = 0;
+    uint64_t snapshotRateChanges = 0;
+    
+    // Input (copied from ServerNetworkManager::getInputStats before printing)
+    uint64_t inputsReceived = 0;
+    uint64_t inputsDuplicate = 0;
+    uint64_t inputsLate = 0;
+    uint64_t inputsStarved = 0;
+    uint64_t inputsIdle = 0;  // Steps of clients that stopped sending
+    uint64_t inputsSkipped = 0;
+    
+    // Shots (copied from ServerNetworkManager::getShotStats before printing)
+    uint64_t shotsFired = 0;
+    uint64_t shotsRejectedFull = 0;      // Queue full
+    uint64_t shotsRejectedStale = 0;     // Reordered
+    uint64_t shotsRejectedCooldown = 0;  // Faster than the weapon allows
+    
+    // Handshake (copied from ServerNetworkManager::getHandshakeStats before printing)
+    uint64_t challengesSent = 0;
+    uint64_t cookiesRejected = 0;       // Bad or expired CHALLENGE_RESPONSE
+    uint64_t connectsRateLimited = 0;   // CONNECT over the per-IP rate
+    uint64_t connectsRejectedFull = 0;  // Server at maxPlayers
+    
+    // Reliability (copied from ServerNetworkManager::getReliableStats before printing)
+    uint64_t reliableSent = 0;
+    uint64_t reliableResent = 0;
+    uint64_t packetsAcked = 0;
+    uint64_t packetsLost = 0;
+    float averageRttMs = 0.0f;  // Over current connections (TimeSync)
+    
+    // Network thread (copied from NetworkThread::Stats before printing)
+    uint64_t datagramsReceived = 0;
+    uint64_t datagramsSent = 0;
+    uint64_t inboundDropped = 0;
+    uint64_t outboundDropped = 0;
+    uint64_t socketSyscalls = 0;
+    uint64_t datagramsTruncated = 0;  // Larger than MAX_PACKET_SIZE, dropped
+    
+    // Packet pool of the game loop thread (copied before printing)
+    uint64_t packetHeapAllocations = 0;  // Must stay flat once warmed up
+    uint32_t packetBuffersInUse = 0;
+    uint32_t packetBuffersPeak = 0;
+    
+    // ECS (copied from World::getComponentMemoryUsage and
+    // forEachComponentMemoryUsage before printing)
+    uint64_t componentMemoryBytes = 0;     // All component storage
+    const char* componentTopType = "-";    // Component type holding the most memory
+    uint64_t componentTopTypeBytes = 0;
+
+    void print(std::ostream& out) const {
+        out << "[Metrics] snapshots sent=" << snapshotsSent
+            << " bytes=" << snapshotBytesSent
+            << " skipped=" << snapshotsSkipped
+            << " fragmented=" << snapshotsFragmented
+            << " fragments=" << fragmentsSent
+            << " deferred=" << entityUpdatesDeferred
+            << " | rate min=" << snapshotRateMin
+            << " avg=" << snapshotRateAverage
+            << " max=" << snapshotRateMax
+            << " congested=" << congestedClients
+            << " changes=" << snapshotRateChanges
+            << " | inputs=" << inputsReceived
+            << " dup=" << inputsDuplicate
+            << " late=" << inputsLate
+            << " starved=" << inputsStarved
+            << " idle=" << inputsIdle
+            << " skipped=" << inputsSkipped
+            << " | shots fired=" << shotsFired
+            << " rejected full=" << shotsRejectedFull
+            << " stale=" << shotsRejectedStale
+            << " cooldown=" << shotsRejectedCooldown
+            << " | challenges=" << challengesSent
+            << " bad cookies=" << cookiesRejected
+            << " rate limited=" << connectsRateLimited
+            << " full=" << connectsRejectedFull
+            << " | reliable sent=" << reliableSent
+            << " resent=" << reliableResent
+            << " acked packets=" << packetsAcked
+            << " lost=" << packetsLost
+            << " avg rtt=" << averageRttMs << "ms"
+            << " | datagrams in=" << datagramsReceived
+            << " out=" << datagramsSent
+            << " dropped in=" << inboundDropped
+            << " out=" << outboundDropped
+            << " syscalls=" << socketSyscalls
+            << " truncated=" << datagramsTruncated
+            << " | packet buffers heap allocs=" << packetHeapAllocations
+            << " in use=" << packetBuffersInUse
+            << " peak=" << packetBuffersPeak
+            << " | component memory=" << componentMemoryBytes
+            << " top type=" << componentTopType << " (" << componentTopTypeBytes << ")"
+            << std::endl;
+    }
+};
+
+} // namespace game::server
@@ -1,5 +1,7 @@
 #include "ServerNetworkManager.hpp"
 #include "../network/PacketTypes.hpp"
+#include "../network/InputCommand.hpp"
+#include "../network/Bundle.hpp"
 #include <SFML/System/Vector2.hpp>
 #include <iostream>
 #include <algorithm>
@@ -7,122 +9,281 @@
 
 namespace game::server {
 
-ServerNetworkManager::ServerNetworkManager() : nextSequenceNumber(1) {
+ServerNetworkManager::ServerNetworkManager() {
 }
 
 ServerNetworkManager::~ServerNetworkManager() {
     shutdown();
 }
 
-bool ServerNetworkManager::initialize(uint16_t port) {
-    if (socket.bind(port) != sf::Socket::Status::Done) {
-        std::cerr << "Failed to bind socket to port " << port << std::endl;
-        return false;
+bool ServerNetworkManager::initialize(uint16_t port, bool useNetworkThread, bool batchedIo, int socketShards) {
+    // Shards need SO_REUSEPORT (batched Linux backend) and a thread each
+    size_t shardCount = useNetworkThread && batchedIo && socketShards > 1 ? static_cast<size_t>(socketShards) : 1;
+    
+    shards.clear();
+    for (size_t i = 0; i < shardCount; ++i) {
+        Shard shard;
+        shard.socket = game::network::createDatagramSocket(batchedIo);
+        if (!shard.socket->bind(port, shardCount > 1)) {
+            if (shardCount > 1 && i == 0) {
+                std::cerr << "SO_REUSEPORT unavailable, using one socket" << std::endl;
+                shardCount = 1;
+                shard.socket = game::network::createDatagramSocket(batchedIo);
+                if (shard.socket->bind(port)) {
+                    shards.push_back(std::move(shard));
+                    break;
+                }
+            }
+            std::cerr << "Failed to bind socket to port " << port << std::endl;
+            shutdown();
+            return false;
+        }
+        shards.push_back(std::move(shard));
+    }
+    
+    if (useNetworkThread) {
+        for (Shard& shard : shards) {
+            shard.thread = std::make_unique<NetworkThread>();
+            shard.thread->start(*shard.socket);
+        }
     }
     
-    socket.setBlocking(false);  // Non-blocking mode
-    std::cout << "Server listening on port " << port << std::endl;
+    std::cout << "Server listening on port " << port;
+    if (useNetworkThread) {
+        std::cout << " (" << shards.size() << (shards.size() > 1 ? " network threads, SO_REUSEPORT)" : " network thread)");
+    }
+    std::cout << std::endl;
     return true;
 }
 
 void ServerNetworkManager::shutdown() {
     connections.clear();
-    socket.unbind();
+    for (Shard& shard : shards) {
+        if (shard.thread) {
+            shard.thread->stop();  // Flushes queued sends, then releases the socket
+            shard.thread.reset();
+        }
+        if (shard.socket) {
+            shard.socket->close();
+            shard.socket.reset();
+        }
+    }
+    shards.clear();
 }
 
 int ServerNetworkManager::processPackets() {
     int packetCount = 0;
     
-    // Temporary buffer for receiving
-    static uint8_t receiveBuffer[MAX_PACKET_SIZE];
-    
-    while (true) {
-        std::size_t received = 0;
-        sf::IpAddress senderIp;
-        unsigned short senderPort;
-        
-        sf::Socket::Status status = socket.receive(
-            receiveBuffer,
-            MAX_PACKET_SIZE,
-            received,
-            senderIp,
-            senderPort
-        );
+    for (uint32_t index = 0; index < shards.size(); ++index) {
+        Shard& shard = shards[index];
+        if (shard.thread) {
+            // Datagrams were already received by the shard's I/O thread
+            while (game::network::Datagram* datagram = shard.thread->receive()) {
+                game::network::Packet packet;
+                packet.setData(datagram->data, datagram->size);
+                handlePacket(datagram->address, connections.find(datagram->address), packet, index);
+                shard.thread->release();
+                packetCount++;
+            }
+            continue;
+        }
         
-        if (status == sf::Socket::Status::NotReady || status == sf::Socket::Status::Disconnected) {
-            break;  // No more packets
+        // Receive in batches (one syscall per batch on Linux)
+        static game::network::Datagram receiveBuffer[game::network::DatagramSocket::MAX_BATCH];
+        game::network::Datagram* slots[game::network::DatagramSocket::MAX_BATCH];
+        for (size_t i = 0; i < game::network::DatagramSocket::MAX_BATCH; ++i) {
+            slots[i] = &receiveBuffer[i];
         }
         
-        if (status == sf::Socket::Status::Done && received > 0) {
-            // Create address from received data
-            game::network::Address from(senderIp, senderPort);
-            
-            // Create packet from received data
-            game::network::Packet packet;
-            packet.setData(receiveBuffer, received);
-            
-            handlePacket(from, packet);
-            packetCount++;
+        while (true) {
+            const size_t received = shard.socket->receiveBatch(slots, game::network::DatagramSocket::MAX_BATCH);
+            for (size_t i = 0; i < received; ++i) {
+                game::network::Packet packet;
+                packet.setData(receiveBuffer[i].data, receiveBuffer[i].size);
+                handlePacket(receiveBuffer[i].address, connections.find(receiveBuffer[i].address), packet, index);
+                packetCount++;
+            }
+            if (received < game::network::DatagramSocket::MAX_BATCH) {
+                break;  // No more packets
+            }
         }
     }
     
     return packetCount;
 }
 
-ServerNetworkManager::LastInput ServerNetworkManager::getLastInput(const game::network::Address& address) const {
-    auto it = lastInputPackets.find(address);
-    if (it != lastInputPackets.end() && it->second.valid) {
-        LastInput result = it->second;
-        it->second.valid = false;  // Mark as consumed
-        return result;
+bool ServerNetworkManager::getNetworkStats(NetworkThread::Stats& out) const {
+    out = NetworkThread::Stats();
+    bool threaded = false;
+    for (const Shard& shard : shards) {
+        if (shard.thread) {
+            out += shard.thread->getStats();
+            threaded = true;
+        }
+    }
+    return threaded;
+}
+
+InputJitterBuffer::Stats ServerNetworkManager::getInputStats() const {
+    InputJitterBuffer::Stats total = closedInputStats;
+    for (const ClientConnection& conn : connections) {
+        total += conn.inputBuffer.getStats();
     }
-    return LastInput{};
+    return total;
 }
 
-void ServerNetworkManager::handlePacket(const game::network::Address& from, const game::network::Packet& packet) {
+game::network::ReliableEndpoint::Stats ServerNetworkManager::getReliableStats() const {
+    game::network::ReliableEndpoint::Stats total = closedReliableStats;
+    for (const ClientConnection& conn : connections) {
+        total += conn.reliable.getStats();
+    }
+    return total;
+}
+
+ShotQueue::Stats ServerNetworkManager::getShotStats() const {
+    ShotQueue::Stats total = closedShotStats;
+    for (const ClientConnection& conn : connections) {
+        total += conn.shots.getStats();
+    }
+    return total;
+}
+
+void ServerNetworkManager::handlePacket(const game::network::Address& from, ConnectionTable::Slot slot,
+                                        const game::network::Packet& packet, uint32_t shard) {
     game::network::PacketType type = packet.getType();
     
+    // Every packet from a known client carries acks for what we sent
+    ClientConnection* connection = slot != ConnectionTable::INVALID_SLOT ? &connections[slot] : nullptr;
+    if (connection) {
+        connection->reliable.onPacketReceived(packet, std::chrono::steady_clock::now());
+    }
+    
     switch (type) {
         case game::network::PacketType::CONNECT: {
-            std::cout << "Client connecting from " << from.toString() << std::endl;
-            // Read initial position from packet
+            // Stateless: answer with a cookie, remember nothing. Padding
+            // keeps the answer no larger than the request.
+            if (connection || packet.getSize() < game::network::MIN_CONNECT_SIZE) {
+                break;  // Already connected (CONNECT_ACK is resent reliably)
+            }
+            if (!gate.allow(from, std::chrono::steady_clock::now())) {
+                break;
+            }
+            if (connections.size() >= connections.capacity()) {
+                sendConnectReject(from, game::network::ConnectRejectReason::SERVER_FULL, shard);
+                break;
+            }
+            const ConnectionGate::Cookie cookie = gate.issue(from, std::chrono::steady_clock::now());
+            game::network::Packet challenge(game::network::PacketType::CHALLENGE);
+            challenge.write(cookie.window);
+            challenge.write(cookie.mac);
+            sendDatagram(shard, from, challenge);
+            ++gate.getStats().challengesSent;
+            break;
+        }
+        
+        case game::network::PacketType::CHALLENGE_RESPONSE: {
+            if (connection) {
+                break;  // Duplicate response
+            }
             game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
             nonConstPacket.resetRead();
+            ConnectionGate::Cookie cookie;
             float posX = 0, posY = 0;
-            nonConstPacket.read(posX);
-            nonConstPacket.read(posY);
-            sf::Vector2f initialPos(posX, posY);
-            // Just handle connection, entity will be spawned by GameServer and CONNECT_ACK sent after
-            handleConnect(from, initialPos);
+            if (!nonConstPacket.read(cookie.window) || !nonConstPacket.read(cookie.mac) ||
+                !nonConstPacket.read(posX) || !nonConstPacket.read(posY)) {
+                break;
+            }
+            uint8_t maxSnapshotRate = 0;  // Optional
+            nonConstPacket.read(maxSnapshotRate);
+            
+            const auto now = std::chrono::steady_clock::now();
+            // Rate limited at CONNECT already; the cookie proves this
+            // address received our CHALLENGE
+            if (!gate.verify(from, cookie, now)) {
+                ++gate.getStats().cookiesRejected;
+                break;
+            }
+            if (connections.size() >= connections.capacity()) {
+                sendConnectReject(from, game::network::ConnectRejectReason::SERVER_FULL, shard);
+                break;
+            }
+            std::cout << "Client connecting from " << from.toString() << std::endl;
+            // Entity will be spawned by GameServer and CONNECT_ACK sent after
+            handleConnect(from, sf::Vector2f(posX, posY), maxSnapshotRate, shard);
             break;
         }
         
         case game::network::PacketType::INPUT: {
-            lastInputPackets[from] = {from, packet, true};
+            if (!connection) {
+                break;
+            }
+            game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+            nonConstPacket.resetRead();
+            InputJitterBuffer& inputBuffer = connection->inputBuffer;
+            game::network::InputCodec::read(nonConstPacket, [&](const game::network::InputCommand& command) {
+                inputBuffer.add(command);
+            });
             break;
         }
         
         case game::network::PacketType::SHOOT: {
+            if (!connection) {
+                break;
+            }
             // Read shoot data from packet
             game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
             nonConstPacket.resetRead();
             float targetX = 0, targetY = 0;
-            game::EntityID playerID = game::INVALID_ENTITY;
-            if (nonConstPacket.read(targetX) && nonConstPacket.read(targetY) && nonConstPacket.read(playerID)) {
+            uint64_t playerHandle = 0;
+            if (nonConstPacket.read(targetX) && nonConstPacket.read(targetY) && nonConstPacket.read(playerHandle)) {
                 ShootEvent event;
-                event.from = from;
                 event.targetPosition = sf::Vector2f(targetX, targetY);
-                event.playerID = playerID;
-                event.valid = true;
-                shootEvents[from] = event;
+                event.playerHandle = playerHandle;
+                if (!nonConstPacket.read(event.viewTick)) {
+                    event.viewTick = 0;  // No rewind
+                }
+                if (!nonConstPacket.read(event.clientTick)) {
+                    event.clientTick = 0;  // Cooldown on server ticks only
+                }
+                connection->shots.push(event);
+            }
+            break;
+        }
+        
+        case game::network::PacketType::SNAPSHOT_ACK: {
+            game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+            nonConstPacket.resetRead();
+            uint32_t ackedSequence = 0;
+            if (connection && nonConstPacket.read(ackedSequence)) {
+                // Acks can arrive out of order; only move the baseline forward
+                if (ackedSequence > connection->lastAckedSnapshot) {
+                    connection->lastAckedSnapshot = ackedSequence;
+                }
             }
             break;
         }
         
         case game::network::PacketType::HEARTBEAT: {
-            auto it = connections.find(from);
-            if (it != connections.end()) {
-                it->second.lastHeartbeat = std::chrono::steady_clock::now();
+            if (connection) {
+                connection->lastHeartbeat = std::chrono::steady_clock::now();
+                
+                // Time sync: the echo of our last heartbeat is an RTT/offset
+                // sample; answer right away so the client gets one too
+                game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+                nonConstPacket.resetRead();
+                uint32_t echoTimestamp = 0, holdMs = 0;
+                nonConstPacket.read(echoTimestamp);
+                nonConstPacket.read(holdMs);
+                game::network::TimeSync& timeSync = connection->reliable.getTimeSync();
+                const uint32_t now = game::network::TimeSync::localTimeMs();
+                timeSync.onEcho(packet.getTimestamp(), echoTimestamp, holdMs, now);
+                timeSync.onRemoteHeartbeat(packet.getTimestamp(), now);
+                
+                game::network::Packet reply(game::network::PacketType::HEARTBEAT);
+                timeSync.getEcho(game::network::TimeSync::localTimeMs(), echoTimestamp, holdMs);
+                reply.write(echoTimestamp);
+                reply.write(holdMs);
+                sendPacket(slot, reply);
             }
             break;
         }
@@ -133,44 +294,141 @@ void ServerNetworkManager::handlePacket(const game::network::Address& from, cons
             break;
         }
         
+        case game::network::PacketType::MESSAGES: {
+            if (!connection) {
+                break;
+            }
+            handleMessages(from, slot, packet, shard);
+            break;
+        }
+        
+        case game::network::PacketType::BUNDLE: {
+            if (!connection) {
+                break;
+            }
+            // Acks were taken from the bundle's header above; entries are
+            // handled as if they had arrived on their own. The client's
+            // message block is the one container allowed inside, and it
+            // only holds leaves, so nesting stops there.
+            game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+            nonConstPacket.resetRead();
+            game::network::BundleCodec::read(nonConstPacket, [&](game::network::Packet& message) {
+                // Stop at a DISCONNECT entry: the slot is gone
+                if (!connections[slot].connected) {
+                    return;
+                }
+                if (message.getType() == game::network::PacketType::MESSAGES) {
+                    handleMessages(from, slot, message, shard);
+                } else if (message.getType() != game::network::PacketType::BUNDLE) {
+                    handlePacket(from, slot, message, shard);
+                }
+            });
+            break;
+        }
+        
         default:
             // Other packet types handled by systems
             break;
     }
 }
 
-bool ServerNetworkManager::sendPacket(const game::network::Address& address, const game::network::Packet& packet) {
-    sf::Socket::Status status = socket.send(
-        packet.getData(),
-        static_cast<std::size_t>(packet.getSize()),
-        address.getIpAddress(),
-        address.getPort()
-    );
-    
-    return status == sf::Socket::Status::Done;
+bool ServerNetworkManager::sendPacket(const game::network::Address& address, game::network::Packet& packet) {
+    const ConnectionTable::Slot slot = connections.find(address);
+    if (slot != ConnectionTable::INVALID_SLOT) {
+        return sendPacket(slot, packet);
+    }
+    return sendDatagram(0, address, packet);
+}
+
+bool ServerNetworkManager::sendPacket(ConnectionTable::Slot slot, game::network::Packet& packet) {
+    ClientConnection& connection = connections[slot];
+    connection.reliable.stampHeader(packet, std::chrono::steady_clock::now());
+    return sendDatagram(connection.shard, connection.address, packet);
+}
+
+void ServerNetworkManager::handleMessages(const game::network::Address& from, ConnectionTable::Slot slot,
+                                          const game::network::Packet& packet, uint32_t shard) {
+    game::network::Packet& nonConstPacket = const_cast<game::network::Packet&>(packet);
+    nonConstPacket.resetRead();
+    connections[slot].reliable.readMessages(nonConstPacket, [&](game::network::Packet& message) {
+        // Messages are leaves: a container inside would nest without bound
+        if (message.getType() != game::network::PacketType::MESSAGES &&
+            message.getType() != game::network::PacketType::BUNDLE) {
+            handlePacket(from, slot, message, shard);
+        }
+        // Stop after a DISCONNECT message: the slot (and this endpoint) was reset
+        return connections[slot].connected;
+    });
+}
+
+bool ServerNetworkManager::sendDatagram(uint32_t shard, const game::network::Address& address,
+                                        const game::network::Packet& packet) {
+    if (shard >= shards.size()) {
+        return false;
+    }
+    // With the I/O thread this only queues the datagram
+    if (shards[shard].thread) {
+        return shards[shard].thread->send(address, packet.getData(), packet.getSize());
+    }
+    return shards[shard].socket->send(address, packet.getData(), packet.getSize());
 }
 
 void ServerNetworkManager::broadcastPacket(const game::network::Packet& packet) {
-    for (const auto& [addr, conn] : connections) {
-        if (conn.connected) {
-            sendPacket(addr, packet);
+    for (ConnectionTable::Slot slot : connections.getActiveSlots()) {
+        if (connections[slot].connected) {
+            game::network::Packet copy = packet;  // Each client gets its own sequence/acks
+            sendPacket(slot, copy);
+        }
+    }
+}
+
+bool ServerNetworkManager::sendMessage(ConnectionTable::Slot slot, game::network::Channel channel,
+                                       const game::network::Packet& message) {
+    if (slot >= connections.capacity() || !connections[slot].connected) {
+        return false;
+    }
+    return connections[slot].reliable.send(channel, message);
+}
+
+void ServerNetworkManager::flushMessages() {
+    const auto now = std::chrono::steady_clock::now();
+    for (ConnectionTable::Slot slot : connections.getActiveSlots()) {
+        ClientConnection& conn = connections[slot];
+        if (!conn.reliable.hasDueMessages(now)) {
+            continue;
         }
+        game::network::Packet packet(game::network::PacketType::MESSAGES);
+        conn.reliable.writeMessages(packet, now);
+        sendPacket(slot, packet);
     }
 }
 
-game::core::Entity ServerNetworkManager::handleConnect(const game::network::Address& address, const sf::Vector2f& initialPosition) {
+game::core::Entity ServerNetworkManager::handleConnect(const game::network::Address& address, const sf::Vector2f& initialPosition,
+                                                       int maxSnapshotRate, uint32_t shard) {
     // Check if client already connected
-    auto it = connections.find(address);
-    if (it != connections.end() && it->second.connected) {
-        return it->second.entity;  // Already connected
+    ConnectionTable::Slot slot = connections.find(address);
+    if (slot != ConnectionTable::INVALID_SLOT && connections[slot].connected) {
+        return connections[slot].entity;  // Already connected
     }
     
-    // Store initial position
-    clientInitialPositions[address] = initialPosition;
+    slot = connections.insert(address);
+    if (slot == ConnectionTable::INVALID_SLOT) {
+        std::cout << "Connection from " << address.toString() << " refused: server full ("
+                  << connections.capacity() << " clients)" << std::endl;
+        return game::core::Entity();
+    }
     
     // Create new connection with invalid entity (will be set by GameServer)
     game::core::Entity invalidEntity;  // Invalid entity, will be set by caller
-    connections[address] = ClientConnection(address, invalidEntity);
+    ClientConnection& connection = connections[slot];
+    connection = ClientConnection(address, invalidEntity);
+    connection.initialPosition = initialPosition;
+    connection.shard = shard < shards.size() ? shard : 0;  // Sticky: the kernel keeps the client on this socket
+    connection.inputBuffer = InputJitterBuffer(inputBufferDelay, inputMaxHoldTicks);
+    connection.shots = ShotQueue(shotCooldownTicks, shotToleranceTicks);
+    connection.congestion = CongestionController(congestionSettings);
+    connection.congestion.setClientCap(maxSnapshotRate);
+    connection.nextSnapshotTime = std::chrono::steady_clock::now();
     
     std::cout << "Client connected: " << address.toString() 
               << " (Total clients: " << connections.size() << ")" << std::endl;
@@ -179,72 +437,72 @@ game::core::Entity ServerNetworkManager::handleConnect(const game::network::Addr
 }
 
 sf::Vector2f ServerNetworkManager::getClientInitialPosition(const game::network::Address& address) const {
-    auto it = clientInitialPositions.find(address);
-    if (it != clientInitialPositions.end()) {
-        return it->second;
+    const ConnectionTable::Slot slot = connections.find(address);
+    if (slot != ConnectionTable::INVALID_SLOT) {
+        return connections[slot].initialPosition;
     }
     return sf::Vector2f(0, 0);  // Default position
 }
 
 void ServerNetworkManager::setClientEntity(const game::network::Address& address, const game::core::Entity& entity) {
-    auto it = connections.find(address);
-    if (it != connections.end()) {
-        it->second.entity = entity;
+    const ConnectionTable::Slot slot = connections.find(address);
+    if (slot != ConnectionTable::INVALID_SLOT) {
+        connections[slot].entity = entity;
     }
 }
 
 void ServerNetworkManager::handleDisconnect(const game::network::Address& address) {
-    auto it = connections.find(address);
-    if (it != connections.end()) {
-        it->second.connected = false;
-        connections.erase(it);
+    const ConnectionTable::Slot slot = connections.find(address);
+    if (slot != ConnectionTable::INVALID_SLOT) {
+        removeConnection(slot);
         std::cout << "Client disconnected: " << address.toString() 
                   << " (Remaining clients: " << connections.size() << ")" << std::endl;
     }
 }
 
+void ServerNetworkManager::sendConnectReject(const game::network::Address& address,
+                                             game::network::ConnectRejectReason reason, uint32_t shard) {
+    ++gate.getStats().rejectedFull;
+    game::network::Packet reject(game::network::PacketType::CONNECT_REJECT);
+    reject.write(static_cast<uint8_t>(reason));
+    sendDatagram(shard, address, reject);
+}
+
+void ServerNetworkManager::removeConnection(ConnectionTable::Slot slot) {
+    ClientConnection& connection = connections[slot];
+    connection.connected = false;
+    closedInputStats += connection.inputBuffer.getStats();
+    closedReliableStats += connection.reliable.getStats();
+    closedShotStats += connection.shots.getStats();
+    connections.erase(slot);
+}
+
 void ServerNetworkManager::checkTimeouts(float timeoutSeconds) {
     auto now = std::chrono::steady_clock::now();
     auto timeout = std::chrono::duration<float>(timeoutSeconds);
     
-    auto it = connections.begin();
-    while (it != connections.end()) {
+    // Backwards: erase() moves the last active slot into the freed position
+    const std::vector<ConnectionTable::Slot>& active = connections.getActiveSlots();
+    for (size_t i = active.size(); i-- > 0;) {
+        const ConnectionTable::Slot slot = active[i];
         auto elapsed = std::chrono::duration_cast<std::chrono::duration<float>>(
-            now - it->second.lastHeartbeat
+            now - connections[slot].lastHeartbeat
         );
         
         if (elapsed > timeout) {
-            std::cout << "Client timeout: " << it->second.address.toString() << std::endl;
-            it = connections.erase(it);
-        } else {
-            ++it;
+            std::cout << "Client timeout: " << connections[slot].address.toString() << std::endl;
+            removeConnection(slot);
         }
     }
 }
 
-void ServerNetworkManager::sendConnectAck(const game::network::Address& address, game::core::Entity::ID entityID) {
-    game::network::Packet packet(game::network::PacketType::CONNECT_ACK);
-    packet.setSequence(nextSequenceNumber++);
-    packet.setTimestamp(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()
-    ).count()));
-    
-    packet.write(entityID);
-    sendPacket(address, packet);
-}
-
-std::vector<std::pair<game::network::Address, ServerNetworkManager::ShootEvent>> ServerNetworkManager::getShootEvents() const {
-    std::vector<std::pair<game::network::Address, ShootEvent>> events;
-    
-    for (auto& [addr, event] : shootEvents) {
-        if (event.valid) {
-            events.emplace_back(addr, event);
-            event.valid = false;  // Mark as consumed
-        }
-    }
-    
-    return events;
+void ServerNetworkManager::sendConnectAck(ConnectionTable::Slot slot, const game::core::Entity& entity, const sf::Vector2f& mapSize) {
+    // Reliable: resent until the client acks it, so a lost ACK can't strand the client
+    game::network::Packet message(game::network::PacketType::CONNECT_ACK);
+    message.write(entity.toHandle());
+    message.write(mapSize.x);
+    message.write(mapSize.y);
+    sendMessage(slot, game::network::Channel::RELIABLE_ORDERED, message);
 }
 
 } // namespace game::server
-
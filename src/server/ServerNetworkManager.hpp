@@ -1,31 +1,20 @@
 #pragma once
 
-#include <unordered_map>
 #include <chrono>
-#include <SFML/Network/UdpSocket.hpp>
+#include <memory>
+#include <vector>
 #include <SFML/System/Vector2.hpp>
 #include "../network/Address.hpp"
 #include "../network/Packet.hpp"
+#include "../network/DatagramSocket.hpp"
+#include "../network/ReliableEndpoint.hpp"
 #include "../core/Entity.hpp"
+#include "NetworkThread.hpp"
+#include "ConnectionTable.hpp"
+#include "ConnectionGate.hpp"
 
 namespace game::server {
 
-/**
- * Client Connection Info
- */
-struct ClientConnection {
-    game::network::Address address;
-    game::core::Entity entity;
-    std::chrono::steady_clock::time_point lastHeartbeat;
-    bool connected;
-    
-    ClientConnection() : connected(false) {}
-    ClientConnection(const game::network::Address& addr, const game::core::Entity& ent)
-        : address(addr), entity(ent), connected(true) {
-        lastHeartbeat = std::chrono::steady_clock::now();
-    }
-};
-
 /**
  * Server Network Manager
  * 
@@ -46,8 +35,13 @@ public:
     
     /**
      * Initialize network (bind socket)
+     * @param useNetworkThread Hand the socket to a dedicated I/O thread
+     * @param batchedIo Use the recvmmsg/sendmmsg backend where available
+     * @param socketShards Sockets sharing the port via SO_REUSEPORT, each
+     *                     with its own I/O thread (falls back to 1 where
+     *                     unsupported or without the network thread)
      */
-    bool initialize(uint16_t port);
+    bool initialize(uint16_t port, bool useNetworkThread = false, bool batchedIo = true, int socketShards = 1);
     
     /**
      * Shutdown network
@@ -55,27 +49,51 @@ public:
     void shutdown();
     
     /**
-     * Process incoming packets
+     * Process incoming packets (from the socket or the I/O thread's queue)
      * Returns number of packets processed
      */
     int processPackets();
     
     /**
      * Send packet to specific client
+     * Packets to connected clients get their sequence number and acks here.
+     * With the I/O thread this only queues the datagram.
+     */
+    bool sendPacket(const game::network::Address& address, game::network::Packet& packet);
+    
+    /**
+     * Send packet to a connected client by slot (no address lookup)
      */
-    bool sendPacket(const game::network::Address& address, const game::network::Packet& packet);
+    bool sendPacket(ConnectionTable::Slot slot, game::network::Packet& packet);
     
     /**
      * Broadcast packet to all connected clients
      */
     void broadcastPacket(const game::network::Packet& packet);
     
+    /**
+     * Queue a message for a client; it rides in the next snapshot or
+     * MESSAGES packet (see ReliableEndpoint)
+     * @return False if the slot is unused or its reliable window is full
+     */
+    bool sendMessage(ConnectionTable::Slot slot, game::network::Channel channel,
+                     const game::network::Packet& message);
+    
+    /**
+     * Send MESSAGES packets to clients with messages due (new ones that
+     * didn't fit into a snapshot, or resends); call once per loop iteration
+     */
+    void flushMessages();
+    
     /**
      * Handle client connection
-     * Returns entity for the new client (invalid if already connected)
+     * Returns entity for the new client (invalid if new, or if the table is full)
      * @param initialPosition Optional initial position from client
+     * @param maxSnapshotRate Snapshot rate cap advertised by the client (0 = none)
+     * @param shard Socket the client's datagrams arrive on; replies use it too
      */
-    game::core::Entity handleConnect(const game::network::Address& address, const sf::Vector2f& initialPosition = sf::Vector2f(0, 0));
+    game::core::Entity handleConnect(const game::network::Address& address, const sf::Vector2f& initialPosition = sf::Vector2f(0, 0),
+                                     int maxSnapshotRate = 0, uint32_t shard = 0);
     
     /**
      * Get initial position for a client (stored during CONNECT)
@@ -87,6 +105,13 @@ public:
      */
     void handleDisconnect(const game::network::Address& address);
     
+    /**
+     * Maximum simultaneous connections (drops current connections)
+     */
+    void setMaxClients(size_t maxClients) {
+        connections.reset(maxClients);
+    }
+    
     /**
      * Check for connection timeouts
      */
@@ -102,7 +127,11 @@ public:
     /**
      * Get all connected clients
      */
-    const std::unordered_map<game::network::Address, ClientConnection, game::network::Address::Hash>& getConnections() const {
+    const ConnectionTable& getConnections() const {
+        return connections;
+    }
+    
+    ConnectionTable& getConnections() {
         return connections;
     }
     
@@ -110,9 +139,9 @@ public:
      * Get client entity by address
      */
     game::core::Entity getClientEntity(const game::network::Address& address) const {
-        auto it = connections.find(address);
-        if (it != connections.end() && it->second.connected) {
-            return it->second.entity;
+        const ConnectionTable::Slot slot = connections.find(address);
+        if (slot != ConnectionTable::INVALID_SLOT && connections[slot].connected) {
+            return connections[slot].entity;
         }
         return game::core::Entity();  // Invalid entity
     }
@@ -123,48 +152,124 @@ public:
     void setClientEntity(const game::network::Address& address, const game::core::Entity& entity);
     
     /**
-     * Get last received INPUT packet for an address (for GameServer processing)
+     * Jitter buffer settings for new connections
      */
-    struct LastInput {
-        game::network::Address from;
-        game::network::Packet packet;
-        bool valid = false;
-    };
-    LastInput getLastInput(const game::network::Address& address) const;
+    void configureInputBuffer(uint32_t targetDelay, uint32_t maxHoldTicks) {
+        inputBufferDelay = targetDelay;
+        inputMaxHoldTicks = maxHoldTicks;
+    }
     
     /**
-     * Shoot event data (from SHOOT packet)
+     * Weapon cooldown for new connections (see ShotQueue)
      */
-    struct ShootEvent {
-        game::network::Address from;
-        sf::Vector2f targetPosition;  // Mouse world position
-        game::EntityID playerID;        // Client's entity ID (for validation)
-        bool valid = false;
-    };
+    void configureShots(uint32_t cooldownTicks, uint32_t toleranceTicks) {
+        shotCooldownTicks = cooldownTicks;
+        shotToleranceTicks = toleranceTicks;
+    }
+    
+    /**
+     * Congestion control settings for new connections
+     */
+    void configureCongestion(const CongestionController::Settings& settings) {
+        congestionSettings = settings;
+    }
+    
+    /**
+     * Cookie handshake and per-IP connect rate limit
+     */
+    void configureHandshake(const ConnectionGate::Settings& settings) {
+        gate = ConnectionGate(settings);
+    }
+    
+    /**
+     * Handshake statistics (challenges, bad cookies, refused attempts)
+     */
+    const ConnectionGate::Stats& getHandshakeStats() const { return gate.getStats(); }
+    
+    /**
+     * Input statistics over all connections, including closed ones
+     */
+    InputJitterBuffer::Stats getInputStats() const;
+    
+    /**
+     * Reliability statistics over all connections, including closed ones
+     */
+    game::network::ReliableEndpoint::Stats getReliableStats() const;
+    
+    /**
+     * Shot statistics (fired, rejected) over all connections, including closed ones
+     */
+    ShotQueue::Stats getShotStats() const;
+    
+    /**
+     * I/O thread statistics summed over all shards
+     * @return False when the socket is used directly (no I/O thread)
+     */
+    bool getNetworkStats(NetworkThread::Stats& out) const;
     
     /**
-     * Get all shoot events from this frame (for ShootingSystem)
-     * Returns vector of (address, shootEvent) pairs
+     * Sockets bound to the port (1 unless sharded with SO_REUSEPORT)
      */
-    std::vector<std::pair<game::network::Address, ShootEvent>> getShootEvents() const;
+    size_t getShardCount() const { return shards.size(); }
     
     /**
-     * Send connect acknowledgment
+     * Send connect acknowledgment (reliable message)
+     * @param mapSize Level size, used by the client to dequantize snapshot positions
      */
-    void sendConnectAck(const game::network::Address& address, game::core::Entity::ID entityID);
+    void sendConnectAck(ConnectionTable::Slot slot, const game::core::Entity& entity, const sf::Vector2f& mapSize);
     
 private:
-    sf::UdpSocket socket;
-    std::unordered_map<game::network::Address, ClientConnection, game::network::Address::Hash> connections;
-    mutable std::unordered_map<game::network::Address, sf::Vector2f, game::network::Address::Hash> clientInitialPositions;
-    mutable std::unordered_map<game::network::Address, LastInput, game::network::Address::Hash> lastInputPackets;
-    mutable std::unordered_map<game::network::Address, ShootEvent, game::network::Address::Hash> shootEvents;
-    uint32_t nextSequenceNumber;
+    /**
+     * One socket on the server port, with its I/O thread if enabled.
+     * Datagrams to a client leave through the shard it arrives on.
+     */
+    struct Shard {
+        std::unique_ptr<game::network::DatagramSocket> socket;
+        std::unique_ptr<NetworkThread> thread;  // Owns the socket while running
+    };
+    std::vector<Shard> shards;
+    ConnectionTable connections;  // All per-client state, by slot
+    ConnectionGate gate;          // Handshake before a slot is given out
+    
+    uint32_t inputBufferDelay = 2;
+    uint32_t inputMaxHoldTicks = 6;
+    uint32_t shotCooldownTicks = 6;
+    uint32_t shotToleranceTicks = 2;
+    CongestionController::Settings congestionSettings;
+    InputJitterBuffer::Stats closedInputStats;  // From connections already removed
+    game::network::ReliableEndpoint::Stats closedReliableStats;
+    ShotQueue::Stats closedShotStats;
     
     /**
      * Handle incoming packet
+     * @param slot Sender's connection (INVALID_SLOT if not connected)
+     * @param shard Socket it arrived on
+     */
+    void handlePacket(const game::network::Address& from, ConnectionTable::Slot slot,
+                      const game::network::Packet& packet, uint32_t shard);
+    
+    /**
+     * Deliver a MESSAGES block (a datagram or a bundle entry) of a
+     * connected client; only leaf messages are handled
+     */
+    void handleMessages(const game::network::Address& from, ConnectionTable::Slot slot,
+                        const game::network::Packet& packet, uint32_t shard);
+    
+    /**
+     * Hand a finished datagram to a shard's I/O thread or socket
+     */
+    bool sendDatagram(uint32_t shard, const game::network::Address& address, const game::network::Packet& packet);
+    
+    /**
+     * Refuse a connect attempt (unreliable, no state kept)
+     */
+    void sendConnectReject(const game::network::Address& address, game::network::ConnectRejectReason reason,
+                           uint32_t shard);
+    
+    /**
+     * Remove a connection, keeping its statistics
      */
-    void handlePacket(const game::network::Address& from, const game::network::Packet& packet);
+    void removeConnection(ConnectionTable::Slot slot);
 };
 
 } // namespace game::server
@@ -0,0 +1,63 @@
+#include "ShotQueue.hpp"
+#include <algorithm>
+
+namespace game::server {
+
+ShotQueue::ShotQueue(uint32_t cooldownTicks, uint32_t toleranceTicks)
+    : cooldownTicks(cooldownTicks)
+    , toleranceTicks(cooldownTicks > 0 ? std::min(toleranceTicks, cooldownTicks - 1) : 0) {
+}
+
+bool ShotQueue::push(const ShootEvent& event) {
+    ++stats.received;
+    if (event.clientTick != 0 && event.clientTick < lastClientTick) {
+        ++stats.rejectedStale;
+        return false;
+    }
+    if (count == CAPACITY) {
+        ++stats.rejectedFull;
+        return false;
+    }
+    if (event.clientTick != 0) {
+        lastClientTick = event.clientTick;
+    }
+    queue[(head + count) % CAPACITY] = event;
+    ++count;
+    return true;
+}
+
+bool ShotQueue::pop(uint32_t serverTick, ShootEvent& out) {
+    while (count > 0) {
+        const ShootEvent& event = queue[head];
+        
+        // Fired faster than the weapon allows on the client's own clock
+        const bool knownTicks = event.clientTick != 0 && lastFiredClientTick != 0;
+        if (cooldownTicks > 0 && knownTicks && event.clientTick - lastFiredClientTick < cooldownTicks) {
+            ++stats.rejectedCooldown;
+            head = (head + 1) % CAPACITY;
+            --count;
+            continue;
+        }
+        
+        if (serverTick + toleranceTicks < nextShotTick) {
+            if (event.clientTick != 0) {
+                return false;  // Spaced correctly but arrived bunched up: wait
+            }
+            ++stats.rejectedCooldown;  // No client tick to tell, the server clock decides
+            head = (head + 1) % CAPACITY;
+            --count;
+            continue;
+        }
+        
+        nextShotTick = std::max(nextShotTick, serverTick) + cooldownTicks;
+        lastFiredClientTick = event.clientTick;
+        ++stats.fired;
+        out = event;
+        head = (head + 1) % CAPACITY;
+        --count;
+        return true;
+    }
+    return false;
+}
+
+} // namespace game::server
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <SFML/System/Vector2.hpp>
+#include "../../include/common/types.hpp"
+
+namespace game::server {
+
+/**
+ * Shoot event data (from SHOOT packet), consumed by ShootingSystem
+ */
+struct ShootEvent {
+    sf::Vector2f targetPosition;    // Mouse world position
+    uint64_t playerHandle = 0;      // Client's entity handle, Entity::toHandle (for validation)
+    uint32_t viewTick = 0;          // Server tick the client was looking at (0 = unknown)
+    uint32_t clientTick = 0;        // Client input tick when fired (0 = unknown)
+};
+
+/**
+ * Shot Queue
+ *
+ * Per-client FIFO of SHOOT commands, so shots arriving in the same frame
+ * all get handled, and the weapon cooldown enforced on the server:
+ * - At most CAPACITY shots wait; more are rejected on arrival
+ * - Shots with an older client tick than the last queued one are
+ *   rejected (reordered packets)
+ * - Cooldown on the client's clock: a shot fired less than cooldownTicks
+ *   client ticks after the previous fired one is rejected
+ * - Cooldown on the server's clock: a shot may fire up to toleranceTicks
+ *   early (jitter), but the next one is due a full cooldown after the
+ *   previous due tick, so the sustained rate never exceeds one shot per
+ *   cooldown whatever the client claims. Correctly spaced shots that
+ *   arrive bunched up wait in the queue instead of being rejected.
+ */
+class ShotQueue {
+public:
+    static constexpr size_t CAPACITY = 8;
+
+    struct Stats {
+        uint64_t received = 0;
+        uint64_t fired = 0;
+        uint64_t rejectedFull = 0;      // Queue full (flooding)
+        uint64_t rejectedStale = 0;     // Older client tick than the last shot
+        uint64_t rejectedCooldown = 0;  // Weapon not ready
+
+        uint64_t rejected() const { return rejectedFull + rejectedStale + rejectedCooldown; }
+
+        Stats& operator+=(const Stats& other) {
+            received += other.received;
+            fired += other.fired;
+            rejectedFull += other.rejectedFull;
+            rejectedStale += other.rejectedStale;
+            rejectedCooldown += other.rejectedCooldown;
+            return *this;
+        }
+    };
+
+    /**
+     * @param cooldownTicks Server ticks between shots (0 = no limit)
+     * @param toleranceTicks How early a shot may be (clamped below the cooldown)
+     */
+    explicit ShotQueue(uint32_t cooldownTicks = 6, uint32_t toleranceTicks = 2);
+
+    /**
+     * Queue a received shot
+     * @return False if rejected
+     */
+    bool push(const ShootEvent& event);
+
+    /**
+     * Next shot allowed to fire at this server tick, in arrival order;
+     * queued shots still on cooldown are rejected on the way
+     * @return False when nothing (more) can fire
+     */
+    bool pop(uint32_t serverTick, ShootEvent& out);
+
+    size_t size() const { return count; }
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    std::array<ShootEvent, CAPACITY> queue;
+    size_t head = 0;
+    size_t count = 0;
+
+    uint32_t cooldownTicks;
+    uint32_t toleranceTicks;
+    uint32_t nextShotTick = 0;     // Weapon ready from this server tick
+    uint32_t lastClientTick = 0;       // Newest queued
+    uint32_t lastFiredClientTick = 0;
+    Stats stats;
+};
+
+} // namespace game::server
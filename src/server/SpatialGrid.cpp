@@ -0,0 +1,62 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+
+namespace game::server {
+
+namespace {
+    uint32_t roundUpToPowerOfTwo(uint32_t value) {
+        uint32_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+SpatialGrid::SpatialGrid(float cellSize, uint32_t bucketCount)
+    : cellSize(cellSize)
+    , inverseCellSize(1.0f / cellSize) {
+    const uint32_t buckets = roundUpToPowerOfTwo(bucketCount);
+    bucketMask = buckets - 1;
+    bucketStart.assign(buckets + 1, 0);
+}
+
+void SpatialGrid::clear() {
+    items.clear();
+    sorted.clear();
+    std::fill(bucketStart.begin(), bucketStart.end(), 0);
+}
+
+void SpatialGrid::insert(uint32_t value, const sf::Vector2f& position) {
+    Item item;
+    item.value = value;
+    item.position = position;
+    item.cellX = cellCoord(position.x);
+    item.cellY = cellCoord(position.y);
+    item.bucket = bucketOf(item.cellX, item.cellY);
+    items.push_back(item);
+}
+
+void SpatialGrid::build() {
+    // Counting sort by bucket: count, prefix sum, scatter
+    std::fill(bucketStart.begin(), bucketStart.end(), 0);
+    for (const Item& item : items) {
+        ++bucketStart[item.bucket + 1];
+    }
+    for (size_t i = 1; i < bucketStart.size(); ++i) {
+        bucketStart[i] += bucketStart[i - 1];
+    }
+
+    sorted.resize(items.size());
+    // Scatter using a running cursor per bucket (reuses the start array)
+    for (const Item& item : items) {
+        sorted[bucketStart[item.bucket]++] = item;
+    }
+    // Cursors now point at the next bucket's start; shift back by one bucket
+    for (size_t i = bucketStart.size() - 1; i > 0; --i) {
+        bucketStart[i] = bucketStart[i - 1];
+    }
+    bucketStart[0] = 0;
+}
+
+} // namespace game::server
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+namespace game::server {
+
+/**
+ * Spatial Grid
+ *
+ * Uniform grid of fixed-size cells hashed into a fixed number of buckets,
+ * so the map size does not have to be known up front.
+ * Rebuilt from scratch each time it is used (insert all, then build()),
+ * which is cheaper than tracking moves for entities that all move.
+ *
+ * Storage is flat (counting sort by bucket), so after warm-up a rebuild
+ * does not allocate.
+ */
+class SpatialGrid {
+public:
+    /**
+     * @param cellSize Cell edge length in pixels (roughly the query size / 4)
+     * @param bucketCount Number of hash buckets (power of two)
+     */
+    explicit SpatialGrid(float cellSize = 64.0f, uint32_t bucketCount = 1024);
+
+    /**
+     * Remove all items (keeps capacity)
+     */
+    void clear();
+
+    /**
+     * Add an item; call build() after the last insert
+     * @param value Caller-defined payload (entity ID, index, ...)
+     */
+    void insert(uint32_t value, const sf::Vector2f& position);
+
+    /**
+     * Sort inserted items into buckets
+     */
+    void build();
+
+    /**
+     * Call fn(value, position) for every item inside rect
+     */
+    template<typename Fn>
+    void query(const sf::FloatRect& rect, Fn&& fn) const {
+        if (items.empty()) return;
+
+        const int32_t minX = cellCoord(rect.left);
+        const int32_t minY = cellCoord(rect.top);
+        const int32_t maxX = cellCoord(rect.left + rect.width);
+        const int32_t maxY = cellCoord(rect.top + rect.height);
+
+        for (int32_t cy = minY; cy <= maxY; ++cy) {
+            for (int32_t cx = minX; cx <= maxX; ++cx) {
+                const uint32_t bucket = bucketOf(cx, cy);
+                for (uint32_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; ++i) {
+                    const Item& item = sorted[i];
+                    // Several cells can share a bucket; only report items
+                    // from the cell being visited so nothing is reported twice
+                    if (item.cellX != cx || item.cellY != cy) continue;
+                    if (item.position.x < rect.left || item.position.x > rect.left + rect.width ||
+                        item.position.y < rect.top || item.position.y > rect.top + rect.height) continue;
+                    fn(item.value, item.position);
+                }
+            }
+        }
+    }
+
+    size_t size() const { return items.size(); }
+
+private:
+    struct Item {
+        uint32_t value;
+        sf::Vector2f position;
+        int32_t cellX;
+        int32_t cellY;
+        uint32_t bucket;
+    };
+
+    float cellSize;
+    float inverseCellSize;
+    uint32_t bucketMask;
+
+    std::vector<Item> items;            // Insert order
+    std::vector<Item> sorted;           // Grouped by bucket
+    std::vector<uint32_t> bucketStart;  // bucket -> first index in sorted (size bucketCount + 1)
+
+    int32_t cellCoord(float value) const {
+        return static_cast<int32_t>(std::floor(value * inverseCellSize));
+    }
+
+    uint32_t bucketOf(int32_t cx, int32_t cy) const {
+        // Large primes spread neighbouring cells across buckets
+        const uint32_t h = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cy) * 19349663u;
+        return h & bucketMask;
+    }
+};
+
+} // namespace game::server
@@ -12,36 +12,30 @@ CollisionSystem::CollisionSystem(const std::vector<sf::FloatRect>& colliders)
 }
 
 void CollisionSystem::update(float deltaTime, game::core::World& world) {
-    // Get all entities with Position, Velocity, and Sprite components
-    auto entities = world.getEntitiesWith<
-        game::core::components::PositionComponent,
+    // Check collision for each entity with Position, Velocity, and Sprite components
+    world.view<
+        const game::core::components::PositionComponent,
         game::core::components::VelocityComponent,
-        game::core::components::SpriteComponent
-    >();
-    
-    // Check collision for each entity
-    for (game::core::Entity::ID entityID : entities) {
-        checkAndResolveCollision(entityID, world, deltaTime);
-    }
+        const game::core::components::SpriteComponent
+    >().each([&](game::core::Entity::ID, const game::core::components::PositionComponent& position,
+                 game::core::components::VelocityComponent& velocity,
+                 const game::core::components::SpriteComponent& sprite) {
+        checkAndResolveCollision(position, velocity, sprite, deltaTime);
+    });
 }
 
-bool CollisionSystem::checkAndResolveCollision(game::core::Entity::ID entityID, game::core::World& world, float deltaTime) {
-    auto* posComp = world.getComponent<game::core::components::PositionComponent>(entityID);
-    auto* velComp = world.getComponent<game::core::components::VelocityComponent>(entityID);
-    auto* spriteComp = world.getComponent<game::core::components::SpriteComponent>(entityID);
-    
-    if (!posComp || !velComp || !spriteComp) {
-        return false;
-    }
-    
+bool CollisionSystem::checkAndResolveCollision(const game::core::components::PositionComponent& position,
+                                               game::core::components::VelocityComponent& velocity,
+                                               const game::core::components::SpriteComponent& sprite,
+                                               float deltaTime) {
     // Calculate next position based on velocity
-    sf::Vector2f nextPosition = posComp->position + velComp->velocity * deltaTime;
+    sf::Vector2f nextPosition = position.position + velocity.velocity * deltaTime;
     
     // Check if would collide at next position
-    if (CollisionHelper::wouldCollideAt(nextPosition, spriteComp->size, colliders)) {
+    if (CollisionHelper::wouldCollideAt(nextPosition, sprite.size, colliders)) {
         // Collision detected - stop movement
-        velComp->velocity.x = 0.0f;
-        velComp->velocity.y = 0.0f;
+        velocity.velocity.x = 0.0f;
+        velocity.velocity.y = 0.0f;
         return true;  // Collision resolved
     }
     
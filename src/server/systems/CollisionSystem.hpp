@@ -2,6 +2,9 @@
 
 #include "../../core/System.hpp"
 #include "../../core/Entity.hpp"
+#include "../../core/components/PositionComponent.hpp"
+#include "../../core/components/VelocityComponent.hpp"
+#include "../../core/components/SpriteComponent.hpp"
 #include "../CollisionHelper.hpp"
 #include <vector>
 #include <SFML/Graphics/Rect.hpp>
@@ -56,12 +59,14 @@ private:
     
     /**
      * Check and resolve collision for a single entity
-     * @param entityID Entity to check
-     * @param world ECS world reference
+     * @param velocity Zeroed if the next step would collide
      * @param deltaTime Time step for position prediction
      * @return True if collision was detected and resolved
      */
-    bool checkAndResolveCollision(game::core::Entity::ID entityID, game::core::World& world, float deltaTime);
+    bool checkAndResolveCollision(const game::core::components::PositionComponent& position,
+                                  game::core::components::VelocityComponent& velocity,
+                                  const game::core::components::SpriteComponent& sprite,
+                                  float deltaTime);
 };
 
 } // namespace game::server::systems
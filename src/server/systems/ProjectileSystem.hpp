@@ -2,6 +2,10 @@
 
 #include "../../core/System.hpp"
 #include "../../core/Entity.hpp"
+#include "../../core/components/PositionComponent.hpp"
+#include "../../core/components/SpriteComponent.hpp"
+#include "../../core/components/ProjectileComponent.hpp"
+#include "../../core/components/LifetimeComponent.hpp"
 #include "../CollisionHelper.hpp"
 #include <vector>
 #include <SFML/Graphics/Rect.hpp>
@@ -10,6 +14,10 @@ namespace game::core {
     class World;
 }
 
+namespace game::server {
+    class LagCompensation;
+}
+
 namespace game::server::systems {
 
 /**
@@ -25,8 +33,10 @@ public:
     /**
      * Constructor
      * @param colliders List of static colliders (walls, obstacles)
+     * @param lagCompensation Player history for rewound hit tests
      */
-    explicit ProjectileSystem(const std::vector<sf::FloatRect>& colliders);
+    ProjectileSystem(const std::vector<sf::FloatRect>& colliders,
+                     const game::server::LagCompensation& lagCompensation);
     
     ~ProjectileSystem() override = default;
     
@@ -52,15 +62,23 @@ public:
 
 private:
     std::vector<sf::FloatRect> colliders;
+    const game::server::LagCompensation& lagCompensation;
+    
+    std::vector<game::core::Entity::ID> toDestroy;  // Reused across updates
     
     /**
      * Check if projectile should be destroyed (collision or timeout)
-     * @param entityID Projectile entity ID
-     * @param world ECS world reference
+     * @param lifetime Advanced by deltaTime
+     * @param world ECS world reference (players, kill counters)
      * @param deltaTime Time step
      * @return True if projectile should be destroyed
      */
-    bool shouldDestroyProjectile(game::core::Entity::ID entityID, game::core::World& world, float deltaTime);
+    bool shouldDestroyProjectile(const game::core::components::PositionComponent& pos,
+                                 const game::core::components::SpriteComponent& sprite,
+                                 const game::core::components::ProjectileComponent& projectile,
+                                 game::core::components::LifetimeComponent& lifetime,
+                                 game::core::World& world,
+                                 float deltaTime);
 };
 
 } // namespace game::server::systems
@@ -6,59 +6,69 @@
 #include "../../core/components/ProjectileComponent.hpp"
 #include "../../core/components/LifetimeComponent.hpp"
 #include "../ServerNetworkManager.hpp"
+#include "../LagCompensation.hpp"
 #include "../../game/GameConstants.hpp"
 #include <cmath>
 #include <iostream>
 
 namespace game::server::systems {
 
-ShootingSystem::ShootingSystem(game::server::ServerNetworkManager& networkManager)
-    : networkManager(networkManager) {
+ShootingSystem::ShootingSystem(game::server::ServerNetworkManager& networkManager,
+                               const game::server::LagCompensation& lagCompensation)
+    : networkManager(networkManager)
+    , lagCompensation(lagCompensation) {
 }
 
 void ShootingSystem::update(float deltaTime, game::core::World& world) {
-    // Get all shoot events from network manager
-    auto shootEvents = networkManager.getShootEvents();
+    // Tick being simulated (the newest recorded one is the previous tick)
+    const uint32_t serverTick = lagCompensation.getNewestTick() + 1;
     
-    for (const auto& [address, event] : shootEvents) {
-        if (!event.valid) {
-            continue;
+    // Each connection's queued shots, in order, as far as the cooldown allows
+    game::server::ShootEvent event;
+    for (game::server::ClientConnection& conn : networkManager.getConnections()) {
+        while (conn.shots.pop(serverTick, event)) {
+            fireShot(world, conn, event);
         }
-        
-        // Get player entity for this address
-        game::core::Entity playerEntity = networkManager.getClientEntity(address);
-        if (!playerEntity.isValid()) {
-            continue;  // Player not found
-        }
-        
-        // Validate player ID matches
-        if (playerEntity.id != event.playerID) {
-            std::cerr << "Warning: Shoot event player ID mismatch for " << address.toString() << std::endl;
-            continue;
-        }
-        
-        // Get player position
-        auto* playerPos = world.getComponent<game::core::components::PositionComponent>(playerEntity.id);
-        if (!playerPos) {
-            continue;  // Player has no position component
-        }
-        
-        // Calculate direction from player to target
-        sf::Vector2f direction = calculateDirection(playerPos->position, event.targetPosition);
-        
-        // Calculate spawn position (player position + offset in direction)
-        sf::Vector2f spawnPosition = playerPos->position + direction * game::client::Constants::PROJECTILE_SPAWN_OFFSET;
-        
-        // Spawn projectile
-        spawnProjectile(world, playerEntity.id, spawnPosition, direction);
     }
 }
 
+void ShootingSystem::fireShot(game::core::World& world, const game::server::ClientConnection& conn,
+                              const game::server::ShootEvent& event) {
+    // Get player entity for this connection
+    game::core::Entity playerEntity = conn.entity;
+    if (!conn.connected || !playerEntity.isValid()) {
+        return;  // Player not found
+    }
+    
+    // Validate the handle matches (ID and generation)
+    if (playerEntity.toHandle() != event.playerHandle) {
+        std::cerr << "Warning: Shoot event player ID mismatch for " << conn.address.toString() << std::endl;
+        return;
+    }
+    
+    // Get player position
+    auto* playerPos = world.getComponent<game::core::components::PositionComponent>(playerEntity.id);
+    if (!playerPos) {
+        return;  // Player has no position component
+    }
+    
+    // Calculate direction from player to target
+    sf::Vector2f direction = calculateDirection(playerPos->position, event.targetPosition);
+    
+    // Calculate spawn position (player position + offset in direction)
+    sf::Vector2f spawnPosition = playerPos->position + direction * game::client::Constants::PROJECTILE_SPAWN_OFFSET;
+    
+    // Spawn projectile (hits are tested against what the shooter saw)
+    spawnProjectile(world, playerEntity.id, spawnPosition, direction,
+                    lagCompensation.rewindTicksFor(event.viewTick));
+}
+
 game::core::Entity ShootingSystem::spawnProjectile(
     game::core::World& world,
     game::EntityID ownerID,
     const sf::Vector2f& spawnPosition,
-    const sf::Vector2f& direction) {
+    const sf::Vector2f& direction,
+    uint32_t rewindTicks) {
     
     // Create entity
     game::core::Entity projectile = world.createEntity();
@@ -86,6 +96,7 @@ game::core::Entity ShootingSystem::spawnProjectile(
         game::client::Constants::PROJECTILE_SPEED,
         direction
     );
+    projComp.rewindTicks = rewindTicks;
     world.addComponent<game::core::components::ProjectileComponent>(projectile.id, projComp);
     
     // Add LifetimeComponent
@@ -11,6 +11,9 @@ namespace game::core {
 
 namespace game::server {
     class ServerNetworkManager;
+    class LagCompensation;
+    struct ClientConnection;
+    struct ShootEvent;
 }
 
 namespace game::server::systems {
@@ -28,14 +31,16 @@ public:
     /**
      * Constructor
      * @param networkManager Reference to network manager (for receiving SHOOT packets)
+     * @param lagCompensation Player history (turns view ticks into rewind ticks)
      */
-    explicit ShootingSystem(game::server::ServerNetworkManager& networkManager);
+    ShootingSystem(game::server::ServerNetworkManager& networkManager,
+                   const game::server::LagCompensation& lagCompensation);
     
     ~ShootingSystem() override = default;
     
     /**
      * Update shooting system
-     * Processes SHOOT packets and spawns projectiles
+     * Drains each client's shot queue (weapon cooldown applies) and spawns projectiles
      */
     void update(float deltaTime, game::core::World& world) override;
     
@@ -48,6 +53,13 @@ public:
 
 private:
     game::server::ServerNetworkManager& networkManager;
+    const game::server::LagCompensation& lagCompensation;
+    
+    /**
+     * Validate a shot from a connection and spawn its projectile
+     */
+    void fireShot(game::core::World& world, const game::server::ClientConnection& conn,
+                  const game::server::ShootEvent& event);
     
     /**
      * Spawn a projectile entity
@@ -55,13 +67,15 @@ private:
      * @param ownerID Entity ID of the player who shot
      * @param spawnPosition Spawn position (player position + offset)
      * @param direction Normalized direction vector
+     * @param rewindTicks How far back the owner's view of other players was
      * @return Created projectile entity
      */
     game::core::Entity spawnProjectile(
         game::core::World& world,
         game::EntityID ownerID,
         const sf::Vector2f& spawnPosition,
-        const sf::Vector2f& direction
+        const sf::Vector2f& direction,
+        uint32_t rewindTicks
     );
     
     /**
@@ -1,4 +1,10 @@
 #include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 #include "core/World.hpp"
 #include "core/components/PositionComponent.hpp"
 #include "core/components/VelocityComponent.hpp"
@@ -9,6 +15,281 @@ using namespace game::core;
 using namespace game::core::components;
 using namespace game::core::systems;
 
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    std::cout << (condition ? "  ok   " : "  FAIL ") << what << std::endl;
+    if (!condition) {
+        ++failures;
+    }
+}
+
+/**
+ * Non-trivial component (heap-allocated string) that counts its live
+ * instances, so leaks and double destruction show up as a wrong count
+ */
+struct NameComponent {
+    static int live;
+    std::string name;
+
+    NameComponent() { ++live; }
+    explicit NameComponent(std::string n) : name(std::move(n)) { ++live; }
+    NameComponent(const NameComponent& other) : name(other.name) { ++live; }
+    NameComponent(NameComponent&& other) noexcept : name(std::move(other.name)) { ++live; }
+    NameComponent& operator=(const NameComponent&) = default;
+    NameComponent& operator=(NameComponent&&) = default;
+    ~NameComponent() { --live; }
+};
+
+int NameComponent::live = 0;
+
+/**
+ * Everything a world's component state shows through its public API:
+ * per entity (Position, Velocity, Name) presence and values, plus the
+ * contents of a two-component and a one-component view (sorted)
+ */
+struct WorldState {
+    std::vector<std::tuple<Entity::ID, int, float, float, std::string>> components;
+    std::vector<std::tuple<Entity::ID, float, float>> movingView;
+    std::vector<std::tuple<Entity::ID, std::string>> nameView;
+
+    bool operator==(const WorldState& other) const {
+        return components == other.components && movingView == other.movingView && nameView == other.nameView;
+    }
+};
+
+WorldState captureState(World& world, Entity::ID maxEntity) {
+    WorldState state;
+    for (Entity::ID id = 0; id <= maxEntity; ++id) {
+        const auto* pos = world.getComponent<PositionComponent>(id);
+        const auto* vel = world.getComponent<VelocityComponent>(id);
+        const auto* name = world.getComponent<NameComponent>(id);
+        const int mask = (pos ? 1 : 0) | (vel ? 2 : 0) | (name ? 4 : 0);
+        state.components.emplace_back(id, mask, pos ? pos->position.x : 0.0f,
+                                      vel ? vel->velocity.x : 0.0f, name ? name->name : std::string());
+    }
+    for (auto [id, pos, vel] : world.view<PositionComponent, VelocityComponent>()) {
+        state.movingView.emplace_back(id, pos.position.x, vel.velocity.x);
+    }
+    for (auto [id, name] : world.view<NameComponent>()) {
+        state.nameView.emplace_back(id, name.name);
+    }
+    std::sort(state.movingView.begin(), state.movingView.end());
+    std::sort(state.nameView.begin(), state.nameView.end());
+    return state;
+}
+
+/**
+ * Sparse-set and archetype backends fed the same operations must show
+ * the same components and views
+ */
+void testStorageBackends() {
+    std::cout << "\n=== Storage Backend Differential Test ===" << std::endl;
+
+    {
+        World sparse(StorageBackend::SparseSet);
+        World archetype(StorageBackend::Archetype);
+        World* worlds[] = {&sparse, &archetype};
+
+        // Three entities in one archetype; removing from the first row
+        // moves the last row into it
+        for (World* world : worlds) {
+            for (int i = 0; i < 3; ++i) {
+                const Entity entity = world->createEntity();
+                world->addComponent<PositionComponent>(entity.id, {static_cast<float>(i), 0.0f});
+                world->addComponent<NameComponent>(entity.id, NameComponent("entity name long enough to allocate " + std::to_string(i)));
+            }
+            world->removeComponent<NameComponent>(0);
+            world->removeComponent<PositionComponent>(0);  // Last component: no archetype left
+        }
+        const WorldState expected = captureState(sparse, 2);
+        check(captureState(archetype, 2) == expected, "swap-with-last removal matches");
+        check(!archetype.hasComponent<PositionComponent>(0) && !archetype.hasComponent<NameComponent>(0),
+              "entity without components has none");
+        const auto* moved = archetype.getComponent<NameComponent>(2);
+        check(moved && moved->name == "entity name long enough to allocate 2", "moved row keeps its string");
+
+        // Empty entity gets components again
+        for (World* world : worlds) {
+            world->addComponent<VelocityComponent>(0, {5.0f, 0.0f});
+            world->addComponent<PositionComponent>(0, {7.0f, 0.0f});
+        }
+        check(captureState(archetype, 2) == captureState(sparse, 2), "emptied entity re-added matches");
+    }
+    check(NameComponent::live == 0, "strings destroyed exactly once (worlds destroyed)");
+
+    // Random operations, compared after every step
+    {
+        constexpr int STEPS = 20000;
+        constexpr Entity::ID MAX_ENTITIES = 64;
+        World sparse(StorageBackend::SparseSet);
+        World archetype(StorageBackend::Archetype);
+        World* worlds[] = {&sparse, &archetype};
+        std::vector<Entity> alive;
+        Entity::ID maxEntity = 0;
+        std::mt19937 rng(42);
+        int mismatchStep = -1;
+
+        for (int step = 0; step < STEPS && mismatchStep < 0; ++step) {
+            const unsigned operation = rng() % 10;
+            if (alive.empty() || (operation == 0 && alive.size() < MAX_ENTITIES)) {
+                Entity created;
+                for (World* world : worlds) {
+                    created = world->createEntity();
+                }
+                alive.push_back(created);
+                maxEntity = std::max(maxEntity, created.id);
+                continue;
+            }
+            const size_t pick = rng() % alive.size();
+            const Entity entity = alive[pick];
+            const float value = static_cast<float>(step);
+            if (operation == 1) {
+                for (World* world : worlds) {
+                    world->destroyEntity(entity);
+                }
+                alive[pick] = alive.back();
+                alive.pop_back();
+            } else if (operation < 6) {
+                const unsigned type = rng() % 3;
+                for (World* world : worlds) {
+                    if (type == 0) {
+                        world->addComponent<PositionComponent>(entity.id, {value, 0.0f});
+                    } else if (type == 1) {
+                        world->addComponent<VelocityComponent>(entity.id, {value, 0.0f});
+                    } else {
+                        world->addComponent<NameComponent>(entity.id, NameComponent(std::string(40, 'a') + std::to_string(step)));
+                    }
+                }
+            } else {
+                const unsigned type = rng() % 3;
+                for (World* world : worlds) {
+                    if (type == 0) {
+                        world->removeComponent<PositionComponent>(entity.id);
+                    } else if (type == 1) {
+                        world->removeComponent<VelocityComponent>(entity.id);
+                    } else {
+                        world->removeComponent<NameComponent>(entity.id);
+                    }
+                }
+            }
+            if (!(captureState(sparse, maxEntity) == captureState(archetype, maxEntity))) {
+                mismatchStep = step;
+            }
+        }
+        if (mismatchStep >= 0) {
+            std::cout << "  first mismatch at step " << mismatchStep << std::endl;
+        }
+        check(mismatchStep < 0, "random add/remove/destroy sequence matches after every step");
+
+        for (World* world : worlds) {
+            world->clear();
+        }
+        check(NameComponent::live == 0, "strings destroyed exactly once (clear)");
+    }
+}
+
+/**
+ * Generational handles: destroyed IDs are reused with a new generation,
+ * and old handles neither validate nor affect the new entity
+ */
+void testEntityHandles() {
+    std::cout << "\n=== Entity Handle Test ===" << std::endl;
+
+    World world;
+    const Entity a = world.createEntity();
+    const Entity b = world.createEntity();
+    const Entity c = world.createEntity();
+    for (const Entity& entity : {a, b, c}) {
+        world.addComponent<PositionComponent>(entity.id, {static_cast<float>(entity.id), 0.0f});
+    }
+    check(world.getEntityCount() == 3, "three live entities");
+
+    world.destroyEntity(b);
+    check(!world.isValidEntity(b) && !world.getEntity(b.id).isValid(), "destroyed handle invalid, ID free");
+    check(world.getEntityCount() == 2, "count drops on destroy");
+
+    const Entity reused = world.createEntity();
+    check(reused.id == b.id && reused.generation == b.generation + 1, "ID reused with the next generation");
+    check(!world.isValidEntity(b) && world.isValidEntity(reused), "old handle stays invalid after reuse");
+    check(world.getEntity(b.id) == reused, "getEntity returns the new handle");
+    check(!world.hasComponent<PositionComponent>(reused.id), "reused ID starts without components");
+
+    world.addComponent<PositionComponent>(reused.id, {42.0f, 0.0f});
+    world.destroyEntity(b);  // Stale: must not touch the new entity
+    const auto* pos = world.getComponent<PositionComponent>(reused.id);
+    check(world.isValidEntity(reused) && pos && pos->position.x == 42.0f, "stale destroy leaves the new entity alone");
+    check(world.getEntityCount() == 3, "stale destroy doesn't change the count");
+    world.destroyEntity(Entity());  // Invalid handle: ignored
+    check(world.getEntityCount() == 3, "invalid handle destroy ignored");
+
+    check(Entity::fromHandle(reused.toHandle()) == reused, "toHandle/fromHandle round-trip");
+    const Entity high(0xFFFFFFFEu, 0xFFFFFFFFu);
+    const Entity back = Entity::fromHandle(high.toHandle());
+    check(back.id == high.id && back.generation == high.generation, "round-trip keeps full 32-bit ID and generation");
+    check(b.toHandle() != reused.toHandle() && !(b == reused), "handles differ across generations");
+
+    // Free IDs keep their next generation (with the free flag), which
+    // must not make them look alive or validate a guessed handle
+    world.destroyEntity(a);
+    world.destroyEntity(c);
+    check(!world.getEntity(a.id).isValid() && !world.getEntity(c.id).isValid(), "free slots have no live handle");
+    check(!world.isValidEntity(Entity(c.id, c.generation + 1)) && !world.isValidEntity(Entity(a.id, a.generation + 1)),
+          "next-generation handles don't validate");
+    check(!world.isValidEntity(Entity(c.id, (c.generation + 1) | 0x80000000u)),
+          "handle carrying the free flag doesn't validate");
+    check(world.getEntityCount() == 1, "count after destroying two");
+
+    const Entity first = world.createEntity();
+    const Entity second = world.createEntity();
+    check(first.id == c.id && second.id == a.id, "most recently destroyed ID is reused first");
+    check(world.getEntity(first.id) == first && world.getEntity(second.id) == second, "both reused IDs resolve");
+    const Entity fresh = world.createEntity();
+    check(fresh.id == 3 && world.getEntityCount() == 4, "new ID once the free list is empty");
+}
+
+/**
+ * Per-type memory figures name the type and add up to no more than the total
+ */
+void testComponentMemoryUsage() {
+    std::cout << "\n=== Component Memory Usage Test ===" << std::endl;
+
+    for (StorageBackend backend : {StorageBackend::SparseSet, StorageBackend::Archetype}) {
+        World world(backend);
+        for (int i = 0; i < 3000; ++i) {
+            const Entity entity = world.createEntity();
+            world.addComponent<PositionComponent>(entity.id, {1.0f, 2.0f});
+            if (i % 10 == 0) {
+                world.addComponent<VelocityComponent>(entity.id, {1.0f, 0.0f});
+            }
+        }
+
+        size_t sum = 0;
+        size_t positionBytes = 0;
+        size_t velocityBytes = 0;
+        int types = 0;
+        world.forEachComponentMemoryUsage([&](game::ComponentTypeID, const char* name, size_t bytes) {
+            sum += bytes;
+            ++types;
+            if (std::strcmp(name, "PositionComponent") == 0) {
+                positionBytes = bytes;
+            } else if (std::strcmp(name, "VelocityComponent") == 0) {
+                velocityBytes = bytes;
+            }
+        });
+        const bool archetype = backend == StorageBackend::Archetype;
+        check(types == 2, archetype ? "archetype: one figure per component type" : "sparse set: one figure per component type");
+        check(positionBytes >= 3000 * sizeof(PositionComponent) && positionBytes > velocityBytes && velocityBytes > 0,
+              archetype ? "archetype: figures named by type, Position largest" : "sparse set: figures named by type, Position largest");
+        check(sum <= world.getComponentMemoryUsage().total,
+              archetype ? "archetype: per-type figures within the total" : "sparse set: per-type figures within the total");
+    }
+}
+
+} // namespace
+
 int main() {
     std::cout << "=== ECS Core Test ===" << std::endl;
     
@@ -67,7 +348,11 @@ int main() {
     bool isValid = world.isValidEntity(player);
     std::cout << "Entity valid after destroy: " << (isValid ? "YES" : "NO") << std::endl;
     
-    std::cout << "\n=== Test Complete ===" << std::endl;
-    return 0;
+    testEntityHandles();
+    testStorageBackends();
+    testComponentMemoryUsage();
+    
+    std::cout << "\n=== Test Complete: " << (failures == 0 ? "all passed" : "FAILURES") << " ===" << std::endl;
+    return failures == 0 ? 0 : 1;
 }
 
@@ -0,0 +1,913 @@
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "server/InputJitterBuffer.hpp"
+#include "server/ServerNetworkManager.hpp"
+#include "server/ConnectionGate.hpp"
+#include "network/DatagramSocket.hpp"
+#include "network/ReliableEndpoint.hpp"
+#include "network/SipHash.hpp"
+#include "network/Snapshot.hpp"
+#include "network/Fragmentation.hpp"
+#include "network/Bundle.hpp"
+
+using namespace game::server;
+using namespace game::network;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    std::cout << (condition ? "  ok   " : "  FAIL ") << what << std::endl;
+    if (!condition) {
+        ++failures;
+    }
+}
+
+/**
+ * Client sending one INPUT per tick (each repeating the last
+ * INPUT_REDUNDANCY commands) over a link with seeded loss and jitter
+ */
+void testInputJitterBuffer() {
+    std::cout << "\n=== InputJitterBuffer Test ===" << std::endl;
+
+    constexpr int STEPS = 100000;
+    constexpr unsigned LOSS_PERCENT = 20;
+    constexpr unsigned MAX_JITTER_TICKS = 2;
+
+    InputJitterBuffer buffer(2, 6);  // ServerConfig defaults
+    std::mt19937 rng(1234);
+    std::vector<InputCommand> sent;
+    struct InFlight {
+        int arrivalTick;
+        std::vector<InputCommand> commands;
+    };
+    std::vector<InFlight> link;
+    uint64_t steps = 0;
+
+    for (int tick = 1; tick <= STEPS; ++tick) {
+        InputCommand command;
+        command.tick = static_cast<uint32_t>(tick);
+        command.velocity = sf::Vector2f(static_cast<float>(tick % 7), 0.0f);
+        sent.push_back(command);
+
+        if (rng() % 100 >= LOSS_PERCENT) {
+            InFlight packet;
+            packet.arrivalTick = tick + static_cast<int>(rng() % (MAX_JITTER_TICKS + 1));
+            for (size_t i = 0; i < INPUT_REDUNDANCY && i < sent.size(); ++i) {
+                packet.commands.push_back(sent[sent.size() - 1 - i]);
+            }
+            link.push_back(packet);
+        }
+
+        for (size_t i = 0; i < link.size();) {
+            if (link[i].arrivalTick <= tick) {
+                for (const InputCommand& arrived : link[i].commands) {
+                    buffer.add(arrived);
+                }
+                link.erase(link.begin() + static_cast<std::ptrdiff_t>(i));
+            } else {
+                ++i;
+            }
+        }
+
+        InputCommand out;
+        if (buffer.consume(out)) {
+            ++steps;
+        }
+    }
+
+    const InputJitterBuffer::Stats stats = buffer.getStats();
+    const double starvedPercent = 100.0 * static_cast<double>(stats.starved) / static_cast<double>(steps);
+    std::cout << "  " << LOSS_PERCENT << "% loss, 0-" << MAX_JITTER_TICKS << " ticks jitter: "
+              << stats.starved << " of " << steps << " steps starved (" << starvedPercent << "%)" << std::endl;
+    check(starvedPercent < 0.5, "starves on under 0.5% of steps");
+    check(stats.idle == 0, "no idle steps while the client is sending");
+
+    // Client goes quiet: after the buffered commands, only the hold counts
+    // as starvation
+    const InputJitterBuffer::Stats before = buffer.getStats();
+    const uint64_t stillBuffered = buffer.size();
+    InputCommand out;
+    for (int i = 0; i < 100; ++i) {
+        buffer.consume(out);
+    }
+    const InputJitterBuffer::Stats after = buffer.getStats();
+    check(after.starved - before.starved == 6, "quiet client: starved only for maxHoldTicks steps");
+    check(after.idle - before.idle == 100 - 6 - stillBuffered, "quiet client: remaining steps counted as idle");
+    check(out.velocity == sf::Vector2f(0.0f, 0.0f), "quiet client is stopped");
+}
+
+/**
+ * SipHash-2-4 reference vectors (key 00..0f, message 00..len-1), from
+ * the SipHash paper's vectors.h read as little-endian 64 bit values
+ */
+void testSipHash() {
+    std::cout << "\n=== SipHash Test ===" << std::endl;
+
+    struct Vector {
+        size_t length;
+        uint64_t hash;
+    };
+    const Vector vectors[] = {
+        {0, 0x726fdb47dd0e0e31ull},
+        {1, 0x74f839c593dc67fdull},
+        {2, 0x0d6c8009d9a94f5aull},
+        {3, 0x85676696d7fb7e2dull},
+        {7, 0xab0200f58b01d137ull},   // Longest without a full block
+        {8, 0x93f5f5799a932462ull},   // One full block, empty tail
+        {9, 0x9e0082df0ba9e4b0ull},
+        {15, 0xa129ca6149be45e5ull},  // The paper's worked example
+        {16, 0x3f2acc7f57c29bdbull},
+        {63, 0x958a324ceb064572ull},
+    };
+
+    uint8_t keyBytes[16];
+    uint8_t message[64];
+    for (uint8_t i = 0; i < 64; ++i) {
+        message[i] = i;
+        if (i < 16) {
+            keyBytes[i] = i;
+        }
+    }
+    SipHashKey key;
+    for (int i = 0; i < 8; ++i) {
+        key.k0 |= static_cast<uint64_t>(keyBytes[i]) << (8 * i);
+        key.k1 |= static_cast<uint64_t>(keyBytes[8 + i]) << (8 * i);
+    }
+
+    bool matches = true;
+    for (const Vector& vector : vectors) {
+        if (sipHash24(key, message, vector.length) != vector.hash) {
+            std::cout << "  length " << vector.length << " mismatch" << std::endl;
+            matches = false;
+        }
+    }
+    check(matches, "reference vectors for lengths 0-63");
+}
+
+/**
+ * Cookies verify in their own and the next window only, for the address
+ * they were issued to
+ */
+void testConnectionGate() {
+    std::cout << "\n=== ConnectionGate Test ===" << std::endl;
+
+    using Clock = ConnectionGate::Clock;
+    ConnectionGate::Settings settings;
+    settings.cookieLifetime = 5.0f;
+    const ConnectionGate gate(settings);
+    // The gate's epoch is just before this, so t0 sits at the start of
+    // window 0 (the margins below dwarf the difference)
+    const Clock::time_point t0 = Clock::now();
+    auto at = [t0](float seconds) {
+        return t0 + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(seconds));
+    };
+
+    const Address address(sf::IpAddress::LocalHost, 5000);
+    const ConnectionGate::Cookie cookie = gate.issue(address, t0);
+    check(gate.verify(address, cookie, t0), "accepted when issued");
+    check(gate.verify(address, cookie, at(4.9f)), "accepted at the end of its window");
+    check(gate.verify(address, cookie, at(5.1f)), "accepted at the start of the next window");
+    check(gate.verify(address, cookie, at(9.9f)), "accepted at the end of the next window");
+    check(!gate.verify(address, cookie, at(10.1f)), "rejected two windows later");
+
+    const ConnectionGate::Cookie later = gate.issue(address, at(5.1f));
+    check(later.window == cookie.window + 1, "window advances after cookieLifetime");
+    check(!gate.verify(address, later, at(4.9f)), "rejected before its window (future)");
+
+    ConnectionGate::Cookie tampered = cookie;
+    tampered.mac ^= 1;
+    check(!gate.verify(address, tampered, t0), "tampered MAC rejected");
+    tampered = cookie;
+    tampered.window += 1;
+    check(!gate.verify(address, tampered, at(5.1f)), "MAC bound to its window");
+    check(!gate.verify(Address(sf::IpAddress::LocalHost, 5001), cookie, t0), "MAC bound to the address");
+}
+
+/**
+ * Per-IP connect limit: a burst, then connectRate, even while a flood of
+ * other (spoofed) IPs collides with the IP's bucket
+ */
+void testConnectRateLimit() {
+    std::cout << "\n=== Connect Rate Limit Test ===" << std::endl;
+
+    using Clock = ConnectionGate::Clock;
+    ConnectionGate::Settings settings;
+    settings.connectRate = 2.0f;
+    settings.connectBurst = 5.0f;
+    settings.bucketCount = 16;  // Every IP shares its bucket with hundreds of flood IPs
+    ConnectionGate gate(settings);
+    const Clock::time_point t0 = Clock::now();
+    auto at = [t0](float seconds) {
+        return t0 + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(seconds));
+    };
+
+    const Address lone(sf::IpAddress(0x0a000001), 5000);
+    int accepted = 0;
+    for (int i = 0; i < 10; ++i) {
+        accepted += gate.allow(lone, t0) ? 1 : 0;
+    }
+    check(accepted == 5, "fresh IP gets connectBurst attempts at once");
+    check(!gate.allow(lone, at(0.4f)) && gate.allow(lone, at(0.5f)), "then one per 1 / connectRate seconds");
+
+    // 10 s of flood from distinct IPs, the repeated IP retrying in between
+    ConnectionGate flooded(settings);
+    const Address repeated(sf::IpAddress(0x0a000002), 5000);
+    uint32_t floodIp = 0x0b000000;
+    int repeatedAccepted = 0;
+    int floodAccepted = 0;
+    constexpr int STEPS = 1000;
+    constexpr float DURATION = 10.0f;
+    for (int step = 0; step < STEPS; ++step) {
+        const Clock::time_point now = at(DURATION * step / STEPS);
+        for (int i = 0; i < 50; ++i) {
+            floodAccepted += flooded.allow(Address(sf::IpAddress(floodIp++), 5000), now) ? 1 : 0;
+        }
+        repeatedAccepted += flooded.allow(repeated, now) ? 1 : 0;
+    }
+    const float limit = settings.connectBurst + settings.connectRate * DURATION;
+    check(repeatedAccepted <= limit, "repeated IP held to connectRate during a flood");
+    check(floodAccepted + repeatedAccepted <= settings.bucketCount * limit, "whole flood bounded by the table's rate");
+    check(flooded.getStats().rateLimited == static_cast<uint64_t>(STEPS * 51 - floodAccepted - repeatedAccepted),
+          "every refused attempt counted");
+}
+
+/**
+ * Home position in a ConnectionTable index of 2^bits entries (same
+ * Fibonacci hashing as ConnectionTable::home)
+ */
+size_t indexHome(const Address& address, uint32_t bits) {
+    return static_cast<size_t>((address.toKey() * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+void testConnectionTable() {
+    std::cout << "\n=== ConnectionTable Test ===" << std::endl;
+
+    // Capacity 8: 16 index entries (4 bits)
+    constexpr uint32_t INDEX_BITS = 4;
+    ConnectionTable table(8);
+
+    // Four ports sharing one home bucket, then one homed in the next
+    // bucket (its probe chain runs through the colliding ones)
+    std::vector<Address> addresses;
+    const size_t home = indexHome(Address(sf::IpAddress::LocalHost, 1000), INDEX_BITS);
+    for (uint16_t port = 1000; addresses.size() < 4; ++port) {
+        const Address address(sf::IpAddress::LocalHost, port);
+        if (indexHome(address, INDEX_BITS) == home) {
+            addresses.push_back(address);
+        }
+    }
+    for (uint16_t port = 2000;; ++port) {
+        const Address address(sf::IpAddress::LocalHost, port);
+        if (indexHome(address, INDEX_BITS) == ((home + 1) & 15)) {
+            addresses.push_back(address);
+            break;
+        }
+    }
+
+    std::vector<ConnectionTable::Slot> slots;
+    for (const Address& address : addresses) {
+        slots.push_back(table.insert(address));
+    }
+    auto resolves = [&](size_t skip) {
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            if (i != skip && table.find(addresses[i]) != slots[i]) {
+                return false;
+            }
+        }
+        return true;
+    };
+    check(resolves(addresses.size()), "colliding keys resolve after insert");
+
+    table.erase(slots[1]);  // Middle of the chain
+    check(table.find(addresses[1]) == ConnectionTable::INVALID_SLOT, "erased key no longer found");
+    check(resolves(1), "rest of the chain resolves after erasing from its middle");
+
+    table.erase(slots[0]);  // Chain head, other home bucket still shifted in
+    slots[1] = table.insert(addresses[1]);
+    check(table.find(addresses[0]) == ConnectionTable::INVALID_SLOT && resolves(0),
+          "chain resolves after erasing its head and reinserting");
+
+    // Dense active list: erase every other connection while walking it
+    // backwards, as checkTimeouts does
+    table.reset(8);
+    for (uint16_t port = 3000; port < 3008; ++port) {
+        table.insert(Address(sf::IpAddress::LocalHost, port));
+    }
+    std::vector<ConnectionTable::Slot> visited;
+    const std::vector<ConnectionTable::Slot>& active = table.getActiveSlots();
+    for (size_t i = active.size(); i-- > 0;) {
+        const ConnectionTable::Slot slot = active[i];
+        visited.push_back(slot);
+        if (slot % 2 == 0) {
+            table.erase(slot);
+        }
+    }
+    std::sort(visited.begin(), visited.end());
+    check(visited == std::vector<ConnectionTable::Slot>({0, 1, 2, 3, 4, 5, 6, 7}), "backwards walk visits each slot once");
+
+    std::vector<ConnectionTable::Slot> remaining(active.begin(), active.end());
+    std::sort(remaining.begin(), remaining.end());
+    check(table.size() == 4 && remaining == std::vector<ConnectionTable::Slot>({1, 3, 5, 7}),
+          "active list holds exactly the remaining slots");
+    bool found = true;
+    for (uint16_t port = 3000; port < 3008; ++port) {
+        const ConnectionTable::Slot slot = table.find(Address(sf::IpAddress::LocalHost, port));
+        found = found && slot == (port % 2 == 0 ? ConnectionTable::INVALID_SLOT : static_cast<ConnectionTable::Slot>(port - 3000));
+    }
+    check(found, "remaining addresses resolve to their slots");
+
+    // Positions stay consistent: erasing the rest through the active list empties it
+    while (!table.empty()) {
+        table.erase(table.getActiveSlots().front());
+    }
+    check(table.size() == 0 && table.find(Address(sf::IpAddress::LocalHost, 3001)) == ConnectionTable::INVALID_SLOT,
+          "table empties through the active list");
+}
+
+bool sameState(const EntityState& a, const EntityState& b) {
+    return a.id == b.id && a.generation == b.generation && a.position == b.position && a.size == b.size && a.color == b.color &&
+           a.hasHealth == b.hasHealth && a.health == b.health && a.maxHealth == b.maxHealth &&
+           a.hasKillCounter == b.hasKillCounter && a.killCount == b.killCount;
+}
+
+bool sameEntities(const Snapshot& a, const Snapshot& b) {
+    if (a.entities.size() != b.entities.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.entities.size(); ++i) {
+        if (!sameState(a.entities[i], b.entities[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Encode a snapshot against a baseline and decode it on the receiving
+ * side; returns the encoded size in bits (0 if decoding failed)
+ */
+size_t deltaRoundTrip(const Snapshot& current, const Snapshot* baseline, const SnapshotSpec& spec,
+                      const SnapshotHistory& receiverHistory, Snapshot& decoded) {
+    uint8_t buffer[4096];
+    BitWriter writer(buffer, sizeof(buffer));
+    SnapshotCodec::writeDelta(writer, current, baseline, spec);
+    BitReader reader(buffer, writer.getBytesWritten());
+    if (writer.hasOverflowed() || !SnapshotCodec::readDelta(reader, receiverHistory, spec, decoded)) {
+        return 0;
+    }
+    return writer.getBitsWritten();
+}
+
+EntityState makeState(game::EntityID id, float x, float y) {
+    EntityState state;
+    state.id = id;
+    state.position = sf::Vector2f(x, y);
+    state.size = sf::Vector2f(16.0f, 16.0f);
+    state.color = 0x3366CCFFu;
+    return state;
+}
+
+/**
+ * Bit-level writer/reader round trip, varints and quantization bounds
+ */
+void testBitStream() {
+    std::cout << "\n=== BitStream Test ===" << std::endl;
+
+    uint8_t buffer[64] = {};
+    BitWriter writer(buffer, sizeof(buffer));
+    writer.writeBits(5, 3);
+    writer.writeBool(true);
+    writer.writeBits(0xDEADBEEFu, 32);  // Straddles byte boundaries
+    const size_t beforeVarints = writer.getBitsWritten();
+    writer.writeVarUint(127);
+    check(writer.getBitsWritten() - beforeVarints == 8, "varuint below 128 costs 8 bits");
+    writer.writeVarUint(128);
+    check(writer.getBitsWritten() - beforeVarints == 24, "varuint 128 costs 16 bits");
+    writer.writeVarUint(0xFFFFFFFFu);
+    writer.writeVarInt(-1);
+    writer.writeVarInt(INT32_MIN);
+    writer.writeFloat(-3.25f);
+    check(!writer.hasOverflowed(), "no overflow within capacity");
+
+    BitReader reader(buffer, writer.getBytesWritten());
+    uint32_t small = 0, word = 0, v127 = 0, v128 = 0, vMax = 0;
+    bool flag = false;
+    int32_t minusOne = 0, minimum = 0;
+    float value = 0.0f;
+    const bool read = reader.readBits(small, 3) && reader.readBool(flag) && reader.readBits(word, 32) &&
+                      reader.readVarUint(v127) && reader.readVarUint(v128) && reader.readVarUint(vMax) &&
+                      reader.readVarInt(minusOne) && reader.readVarInt(minimum) && reader.readFloat(value);
+    check(read && small == 5 && flag && word == 0xDEADBEEFu && v127 == 127 && v128 == 128 &&
+          vMax == 0xFFFFFFFFu && minusOne == -1 && minimum == INT32_MIN && value == -3.25f,
+          "mixed-width values round-trip");
+
+    uint8_t tiny[2];
+    BitWriter full(tiny, sizeof(tiny));
+    full.writeBits(0xFFFF, 16);
+    full.writeBits(1, 1);
+    check(full.hasOverflowed() && full.getBitsWritten() == 16, "write past capacity flagged and dropped");
+    BitReader shortReader(tiny, sizeof(tiny));
+    uint32_t bits = 0;
+    check(!shortReader.readBits(bits, 17) && shortReader.hasFailed() && !shortReader.readBits(bits, 1),
+          "read past the end fails and stays failed");
+
+    // Quantization: 1/16 px inside the map plus margin, clamped outside
+    const SnapshotSpec spec(sf::Vector2f(1024.0f, 768.0f));
+    check(spec.positionX.bits == 15 && spec.positionY.bits == 14, "position bits follow the map size");
+    check(spec.health.bits == 8 && spec.size.bits == 10, "health 8 bits, size 10 bits");
+    check(spec.positionX.round(10.03f) == 10.0f && spec.positionX.round(10.04f) == 10.0625f, "positions rounded to 1/16 px");
+    check(spec.positionX.round(-1000.0f) == -SnapshotSpec::MAP_MARGIN &&
+          spec.positionX.round(5000.0f) == 1024.0f + SnapshotSpec::MAP_MARGIN, "positions clamped to map plus margin");
+    check(spec.positionX.round(-SnapshotSpec::MAP_MARGIN) == -SnapshotSpec::MAP_MARGIN &&
+          spec.positionY.round(768.0f + SnapshotSpec::MAP_MARGIN) == 768.0f + SnapshotSpec::MAP_MARGIN,
+          "bounds themselves are representable");
+    check(spec.health.round(100.0f) == 63.75f && spec.health.round(-1.0f) == 0.0f, "health clamped to its range");
+
+    // Same bounds through the snapshot codec
+    Snapshot snapshot;
+    snapshot.sequence = 1;
+    EntityState state;
+    state.id = 9;
+    state.position = sf::Vector2f(-500.0f, 2000.0f);
+    state.size = sf::Vector2f(100.0f, 0.04f);
+    state.hasHealth = true;
+    state.health = 70.0f;
+    state.maxHealth = 10.0f;
+    state.hasKillCounter = true;
+    state.killCount = -70000;
+    snapshot.entities.push_back(state);
+
+    uint8_t packed[256];
+    BitWriter snapshotWriter(packed, sizeof(packed));
+    SnapshotCodec::writeDelta(snapshotWriter, snapshot, nullptr, spec);
+    BitReader snapshotReader(packed, snapshotWriter.getBytesWritten());
+    SnapshotHistory history;
+    Snapshot decoded;
+    const bool decodedOk = SnapshotCodec::readDelta(snapshotReader, history, spec, decoded) && decoded.entities.size() == 1;
+    const EntityState& out = decodedOk ? decoded.entities[0] : state;
+    check(decodedOk && out.position == sf::Vector2f(-64.0f, 832.0f), "decoded position clamped to the bounds");
+    check(decodedOk && out.size == sf::Vector2f(63.9375f, 0.0625f) && out.health == 63.75f && out.maxHealth == 10.0f,
+          "decoded size and health quantized");
+    check(decodedOk && out.killCount == -70000, "negative kill count survives the varint");
+}
+
+/**
+ * Delta snapshots rebuild the full state from the receiver's baseline:
+ * changed, unchanged, added and removed entities
+ */
+void testSnapshotDelta() {
+    std::cout << "\n=== Snapshot Delta Test ===" << std::endl;
+
+    const SnapshotSpec spec(sf::Vector2f(1024.0f, 768.0f));
+    SnapshotHistory receiver;
+
+    Snapshot first;
+    first.sequence = 10;
+    first.tick = 100;
+    first.inputAck = 7;
+    for (game::EntityID id : {1u, 2u, 3u, 40u, 300u}) {
+        first.entities.push_back(makeState(id, 10.0f * static_cast<float>(id), 20.0f));
+    }
+    first.entities[1].hasHealth = true;
+    first.entities[1].health = 7.5f;
+    first.entities[1].maxHealth = 10.0f;
+    first.entities[2].hasKillCounter = true;
+    first.entities[2].killCount = 3;
+    first.entities[4].generation = 200;  // Two-byte varuint
+    for (EntityState& state : first.entities) {
+        SnapshotCodec::quantize(state, spec);
+    }
+
+    Snapshot decoded;
+    check(deltaRoundTrip(first, nullptr, spec, receiver, decoded) > 0 && sameEntities(decoded, first) &&
+          decoded.sequence == 10 && decoded.tick == 100 && decoded.inputAck == 7,
+          "full snapshot (no baseline) round-trips");
+    Snapshot& stored = receiver.insert(decoded.sequence);
+    stored.entities = decoded.entities;
+
+    // 1 unchanged, 2 moved, 3 gone, 40 lost its health, 300 kills changed, 77 new
+    Snapshot second = first;
+    second.sequence = 12;
+    second.tick = 104;
+    second.entities[1].position.x += 1.5f;
+    second.entities[3].hasHealth = false;
+    second.entities[4].hasKillCounter = true;
+    second.entities[4].killCount = -2;
+    second.entities.erase(second.entities.begin() + 2);
+    second.entities.push_back(makeState(77, 5.0f, 5.0f));
+    second.sortEntities();
+
+    const size_t deltaBits = deltaRoundTrip(second, &first, spec, receiver, decoded);
+    check(deltaBits > 0 && sameEntities(decoded, second), "delta against baseline rebuilds the full state");
+    const size_t fullBits = deltaRoundTrip(second, nullptr, spec, receiver, decoded);
+    check(deltaBits < fullBits, "delta smaller than the full snapshot");
+
+    // Colour is only sent when it changed
+    Snapshot moved = first;
+    moved.sequence = 11;
+    moved.entities[0].position.x += 1.0f;
+    Snapshot recoloured = moved;
+    recoloured.entities[0].color = 0xFF0000FFu;
+    const size_t movedBits = deltaRoundTrip(moved, &first, spec, receiver, decoded);
+    check(movedBits > 0 && sameEntities(decoded, moved), "position-only change round-trips");
+    const size_t recolouredBits = deltaRoundTrip(recoloured, &first, spec, receiver, decoded);
+    check(recolouredBits > 0 && sameEntities(decoded, recoloured), "colour change round-trips");
+    check(recolouredBits == movedBits + 32, "unchanged colour costs no bits");
+
+    Snapshot unchanged = first;
+    unchanged.sequence = 13;
+    check(deltaRoundTrip(unchanged, &first, spec, receiver, decoded) > 0 && sameEntities(decoded, first),
+          "nothing changed: baseline state");
+
+    // Same ID, new generation: sent in full as a new entity
+    Snapshot reused = first;
+    reused.sequence = 15;
+    reused.entities[0].generation = 1;
+    const size_t unchangedBits = deltaRoundTrip(unchanged, &first, spec, receiver, decoded);
+    const size_t reusedBits = deltaRoundTrip(reused, &first, spec, receiver, decoded);
+    check(reusedBits > 0 && sameEntities(decoded, reused) && decoded.entities[0].generation == 1,
+          "reused ID decoded with its new generation");
+    check(reusedBits - unchangedBits == 8 + SnapshotCodec::fieldBits(reused.entities[0], SnapshotCodec::FIELD_ALL, spec),
+          "reused ID sent in full though no field changed");
+
+    Snapshot orphan = second;
+    orphan.sequence = 14;
+    Snapshot missing = second;  // Baseline 12 was never stored by the receiver
+    check(deltaRoundTrip(orphan, &missing, spec, receiver, decoded) == 0, "unknown baseline rejected");
+}
+
+/**
+ * Fragments of a payload of the given size (byte i = i * 7 + seed)
+ */
+std::vector<Packet> makeFragments(uint32_t snapshotId, size_t size, uint8_t seed, std::vector<uint8_t>& payload) {
+    payload.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        payload[i] = static_cast<uint8_t>(i * 7 + seed);
+    }
+    std::vector<Packet> fragments;
+    sendFragmented(snapshotId, payload.data(), payload.size(), [&](const Packet& packet) {
+        fragments.push_back(packet);
+    });
+    return fragments;
+}
+
+bool addFragment(FragmentAssembler& assembler, const Packet& fragment, FragmentAssembler::Clock::time_point now) {
+    Packet received = fragment;
+    received.resetRead();
+    return assembler.addFragment(received, now);
+}
+
+bool completedWith(const FragmentAssembler& assembler, const std::vector<uint8_t>& payload) {
+    return assembler.getSize() == payload.size() &&
+           std::equal(payload.begin(), payload.end(), assembler.getData());
+}
+
+/**
+ * Reassembly with fragments out of order, duplicated, stale, and spread
+ * over the assembler's four in-flight sets
+ */
+void testFragmentAssembler() {
+    std::cout << "\n=== Fragment Assembler Test ===" << std::endl;
+
+    using Clock = FragmentAssembler::Clock;
+    const Clock::time_point now = Clock::now();
+    FragmentAssembler assembler(0.5f);
+    std::vector<uint8_t> payload;
+
+    std::vector<Packet> fragments = makeFragments(1, 3 * FRAGMENT_PAYLOAD_SIZE + 100, 1, payload);
+    check(fragments.size() == 4, "payload split into 4 fragments");
+    check(sendFragmented(2, payload.data(), MAX_FRAGMENTED_SIZE + 1, [](const Packet&) {}) == 0,
+          "payload over MAX_FRAGMENTED_SIZE refused");
+
+    // Reverse order with a duplicate in the middle
+    bool completedEarly = addFragment(assembler, fragments[3], now);
+    completedEarly = addFragment(assembler, fragments[2], now) || completedEarly;
+    completedEarly = addFragment(assembler, fragments[2], now) || completedEarly;
+    completedEarly = addFragment(assembler, fragments[1], now) || completedEarly;
+    const bool completed = addFragment(assembler, fragments[0], now);
+    check(!completedEarly && completed, "completes on the last missing fragment only");
+    check(completedWith(assembler, payload) && assembler.getCompletedId() == 1, "out-of-order fragments reassemble");
+    check(assembler.getStats().snapshotsReassembled == 1, "duplicate doesn't complete a set twice");
+    check(!addFragment(assembler, fragments[0], now), "fragment of a completed set ignored");
+
+    // Four sets in flight (2..5), one fragment each; a fifth evicts the oldest
+    std::vector<std::vector<uint8_t>> payloads(6);
+    std::vector<std::vector<Packet>> sets(6);
+    for (uint32_t id = 2; id <= 5; ++id) {
+        sets[id] = makeFragments(id, 2 * FRAGMENT_PAYLOAD_SIZE + id, static_cast<uint8_t>(id), payloads[id]);
+        addFragment(assembler, sets[id][1], now);
+    }
+    check(assembler.getStats().snapshotsDropped == 0, "four sets fit in flight");
+    std::vector<uint8_t> sixth;
+    std::vector<Packet> sixthSet = makeFragments(6, 2 * FRAGMENT_PAYLOAD_SIZE, 6, sixth);
+    addFragment(assembler, sixthSet[0], now);
+    check(assembler.getStats().snapshotsDropped == 1 && assembler.getStats().fragmentsLost == 2,
+          "fifth set evicts the oldest (2 fragments lost)");
+    check(!addFragment(assembler, sets[2][0], now) && assembler.getStats().snapshotsDropped == 1,
+          "set older than all in flight refused, nothing evicted");
+
+    // Interleaved sets complete independently, each with its own data
+    addFragment(assembler, sets[5][0], now);
+    addFragment(assembler, sets[3][0], now);
+    const uint64_t droppedBefore = assembler.getStats().snapshotsDropped;
+    const bool fiveDone = addFragment(assembler, sets[5][2], now);
+    check(fiveDone && completedWith(assembler, payloads[5]), "interleaved set completes with its own data");
+    check(assembler.getStats().snapshotsDropped == droppedBefore + 2 && !addFragment(assembler, sets[4][0], now),
+          "older sets (3, 4) dropped once a newer one completes");
+    check(addFragment(assembler, sixthSet[1], now) && completedWith(assembler, sixth), "newer set still completes");
+    check(!addFragment(assembler, sets[2][1], now), "stale sequence rejected");
+
+    // Timeout
+    std::vector<uint8_t> late;
+    std::vector<Packet> lateSet = makeFragments(7, 2 * FRAGMENT_PAYLOAD_SIZE, 7, late);
+    addFragment(assembler, lateSet[0], now);
+    const uint64_t droppedBeforeExpire = assembler.getStats().snapshotsDropped;
+    assembler.expire(now + std::chrono::milliseconds(400));
+    check(assembler.getStats().snapshotsDropped == droppedBeforeExpire, "set kept within the timeout");
+    assembler.expire(now + std::chrono::milliseconds(600));
+    check(assembler.getStats().snapshotsDropped == droppedBeforeExpire + 1, "incomplete set dropped after the timeout");
+    check(!addFragment(assembler, lateSet[1], now + std::chrono::milliseconds(600)),
+          "expired set starts over instead of completing");
+}
+
+/**
+ * Acks the receiver would send for the packets it has seen
+ */
+void stampAcks(ReliableEndpoint& receiver, uint32_t& ack, uint32_t& ackBits) {
+    Packet reply(PacketType::HEARTBEAT);
+    receiver.stampHeader(reply, std::chrono::steady_clock::now());
+    ack = reply.getAck();
+    ackBits = reply.getAckBits();
+}
+
+void receiveSequence(ReliableEndpoint& receiver, uint32_t sequence) {
+    Packet packet(PacketType::HEARTBEAT);
+    packet.setSequence(sequence);
+    receiver.onPacketReceived(packet, std::chrono::steady_clock::now());
+}
+
+/**
+ * 32 bit ack field: newest sequence plus one bit per earlier one,
+ * across sequence wrap; sequence 0 (unstamped) is ignored
+ */
+void testAckWindow() {
+    std::cout << "\n=== Ack Window Test ===" << std::endl;
+
+    uint32_t ack = 0, ackBits = 0;
+    ReliableEndpoint receiver;
+    for (uint32_t sequence = 1; sequence <= 40; ++sequence) {
+        if (sequence != 5 && sequence != 38) {
+            receiveSequence(receiver, sequence);
+        }
+    }
+    stampAcks(receiver, ack, ackBits);
+    check(ack == 40, "ack is the newest sequence");
+    check((ackBits & 1u) && !(ackBits & 2u), "bit i is sequence ack - 1 - i (38 missing)");
+    check(ackBits == ~2u, "32 sequences before the newest covered (5 outside the window)");
+
+    receiveSequence(receiver, 38);  // Late arrival
+    receiveSequence(receiver, 0);   // Unstamped (CONNECT etc.)
+    stampAcks(receiver, ack, ackBits);
+    check(ack == 40 && ackBits == ~0u, "late packet fills its bit, sequence 0 ignored");
+
+    ReliableEndpoint fresh;
+    receiveSequence(fresh, 0);
+    stampAcks(fresh, ack, ackBits);
+    check(ack == 0 && ackBits == 0, "sequence 0 alone acks nothing");
+
+    // Across wrap: ... 0xFFFFFFFE, 0xFFFFFFFF, (0 is never sent), 1, 2
+    ReliableEndpoint wrapping;
+    for (uint32_t sequence = 0xFFFFFFF0u; sequence != 0; ++sequence) {
+        receiveSequence(wrapping, sequence);
+    }
+    receiveSequence(wrapping, 1);
+    receiveSequence(wrapping, 2);
+    receiveSequence(wrapping, 0xFFFFFFF8u);  // Old duplicate from before the wrap
+    stampAcks(wrapping, ack, ackBits);
+    check(ack == 2, "newest sequence after wrap");
+    check((ackBits & 1u) && !(ackBits & 2u) && (ackBits & 4u) && (ackBits & (1u << 17)),
+          "window spans the wrap (1, 0xFFFFFFFF, 0xFFFFFFF0 acked; 0 not)");
+
+    // Sender side: acks across the SENT_WINDOW ring
+    ReliableEndpoint sender;
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 300; ++i) {
+        Packet packet(PacketType::HEARTBEAT);
+        sender.stampHeader(packet, now);
+    }
+    Packet acks(PacketType::HEARTBEAT);
+    acks.setAck(300, ~0u);
+    sender.onPacketReceived(acks, now);
+    check(sender.getStats().packetsAcked == 33, "ack plus 32 bits acknowledges 33 packets");
+    acks.setAck(10, 0);  // Overwritten in the ring by sequence 266
+    sender.onPacketReceived(acks, now);
+    check(sender.getStats().packetsAcked == 33, "ack for a sequence no longer remembered ignored");
+    check(sender.getStats().packetsLost == 256 - 33, "unacked packets still in the ring (45-267) judged lost");
+
+    ReliableEndpoint early;
+    for (int i = 0; i < 3; ++i) {
+        Packet packet(PacketType::HEARTBEAT);
+        early.stampHeader(packet, now);
+    }
+    acks.setAck(3, ~0u);  // Bits reach below sequence 1
+    early.onPacketReceived(acks, now);
+    check(early.getStats().packetsAcked == 3 && early.getStats().packetsLost == 0, "bits below sequence 1 ignored");
+}
+
+/**
+ * Send one datagram to the server and let it handle what arrives
+ * @return Packets handled
+ */
+int sendToServer(ServerNetworkManager& server, DatagramSocket& client, uint16_t serverPort, const Packet& packet) {
+    client.send(Address(sf::IpAddress::LocalHost, serverPort), packet.getData(), packet.getSize());
+    int handled = 0;
+    for (int attempt = 0; attempt < 100 && handled == 0; ++attempt) {
+        handled = server.processPackets();
+        if (handled == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return handled;
+}
+
+Packet makeInput(uint32_t tick) {
+    Packet input(PacketType::INPUT);
+    InputCommand command;
+    command.tick = tick;
+    command.velocity = sf::Vector2f(1.0f, 0.0f);
+    InputCodec::write(input, &command, 1);
+    return input;
+}
+
+/**
+ * MESSAGES block [DISCONNECT, INPUT]: the DISCONNECT frees the slot
+ * (and resets its endpoint), so the INPUT must not be delivered
+ */
+void testMessagesDisconnect() {
+    std::cout << "\n=== MESSAGES Disconnect Test ===" << std::endl;
+
+    constexpr uint16_t SERVER_PORT = 47310;
+    constexpr uint16_t CLIENT_PORT = 47311;
+    ServerNetworkManager server;
+    std::unique_ptr<DatagramSocket> client = createDatagramSocket();
+    if (!server.initialize(SERVER_PORT) || !client->bind(CLIENT_PORT)) {
+        check(false, "loopback sockets bound");
+        return;
+    }
+
+    const Address clientAddress(sf::IpAddress::LocalHost, CLIENT_PORT);
+    server.handleConnect(clientAddress);
+    const ConnectionTable::Slot slot = server.getConnections().find(clientAddress);
+    check(server.getClientCount() == 1, "client connected");
+
+    ReliableEndpoint endpoint;
+    Packet disconnect(PacketType::DISCONNECT);
+    endpoint.send(Channel::RELIABLE_ORDERED, disconnect);
+    endpoint.send(Channel::UNRELIABLE_SEQUENCED, makeInput(1));  // Written after the reliable DISCONNECT
+
+    const auto now = std::chrono::steady_clock::now();
+    Packet packet(PacketType::MESSAGES);
+    endpoint.writeMessages(packet, now);
+    endpoint.stampHeader(packet, now);
+
+    check(sendToServer(server, *client, SERVER_PORT, packet) == 1, "MESSAGES packet received");
+    check(server.getClientCount() == 0, "DISCONNECT message closed the connection");
+    check(server.getConnections()[slot].inputBuffer.size() == 0, "INPUT after DISCONNECT not applied to the freed slot");
+
+    server.shutdown();
+}
+
+/**
+ * Containers inside a MESSAGES block or a BUNDLE are dropped, not
+ * unpacked; only a bundle's own message block is read
+ */
+void testNestedContainers() {
+    std::cout << "\n=== Nested Container Test ===" << std::endl;
+
+    constexpr uint16_t SERVER_PORT = 47312;
+    constexpr uint16_t CLIENT_PORT = 47313;
+    ServerNetworkManager server;
+    std::unique_ptr<DatagramSocket> client = createDatagramSocket();
+    if (!server.initialize(SERVER_PORT) || !client->bind(CLIENT_PORT)) {
+        check(false, "loopback sockets bound");
+        return;
+    }
+
+    const Address clientAddress(sf::IpAddress::LocalHost, CLIENT_PORT);
+    server.handleConnect(clientAddress);
+    const ConnectionTable::Slot slot = server.getConnections().find(clientAddress);
+    const InputJitterBuffer& inputBuffer = server.getConnections()[slot].inputBuffer;
+    ReliableEndpoint endpoint;
+
+    // One MESSAGES datagram carrying a single message
+    auto sendMessage = [&](const Packet& message) {
+        const auto now = std::chrono::steady_clock::now();
+        endpoint.send(Channel::UNRELIABLE_SEQUENCED, message);
+        Packet packet(PacketType::MESSAGES);
+        endpoint.writeMessages(packet, now);
+        endpoint.stampHeader(packet, now);
+        return sendToServer(server, *client, SERVER_PORT, packet);
+    };
+
+    Packet bundle(PacketType::BUNDLE);
+    BundleCodec::append(bundle, makeInput(1));
+    check(sendMessage(bundle) == 1, "MESSAGES{BUNDLE{INPUT}} received");
+    check(inputBuffer.size() == 0, "BUNDLE inside MESSAGES not unpacked");
+
+    ReliableEndpoint inner;
+    inner.send(Channel::UNRELIABLE_SEQUENCED, makeInput(2));
+    Packet messages(PacketType::MESSAGES);
+    inner.writeMessages(messages, std::chrono::steady_clock::now());
+    check(sendMessage(messages) == 1, "MESSAGES{MESSAGES{INPUT}} received");
+    check(inputBuffer.size() == 0, "MESSAGES inside MESSAGES not unpacked");
+
+    check(sendMessage(makeInput(3)) == 1, "MESSAGES{INPUT} received");
+    check(inputBuffer.size() == 1, "INPUT inside MESSAGES applied");
+
+    // One BUNDLE datagram carrying a message block, as the client sends it
+    auto sendBundle = [&](const Packet& message) {
+        const auto now = std::chrono::steady_clock::now();
+        endpoint.send(Channel::UNRELIABLE_SEQUENCED, message);
+        Packet block(PacketType::MESSAGES);
+        endpoint.writeMessages(block, now);
+        Packet packet(PacketType::BUNDLE);
+        BundleCodec::append(packet, block);
+        endpoint.stampHeader(packet, now);
+        return sendToServer(server, *client, SERVER_PORT, packet);
+    };
+
+    Packet nestedBundle(PacketType::BUNDLE);
+    BundleCodec::append(nestedBundle, bundle);
+    endpoint.stampHeader(nestedBundle, std::chrono::steady_clock::now());
+    check(sendToServer(server, *client, SERVER_PORT, nestedBundle) == 1, "BUNDLE{BUNDLE{INPUT}} received");
+    check(inputBuffer.size() == 1, "BUNDLE inside BUNDLE not unpacked");
+
+    check(sendBundle(bundle) == 1, "BUNDLE{MESSAGES{BUNDLE{INPUT}}} received");
+    check(inputBuffer.size() == 1, "BUNDLE inside a bundled MESSAGES block not unpacked");
+
+    check(sendBundle(messages) == 1, "BUNDLE{MESSAGES{MESSAGES{INPUT}}} received");
+    check(inputBuffer.size() == 1, "MESSAGES inside a bundled MESSAGES block not unpacked");
+
+    check(sendBundle(makeInput(4)) == 1, "BUNDLE{MESSAGES{INPUT}} received");
+    check(inputBuffer.size() == 2, "INPUT inside a bundled MESSAGES block applied");
+    check(server.getClientCount() == 1, "client still connected");
+
+    server.shutdown();
+}
+
+/**
+ * readMessages stops as soon as deliver returns false
+ */
+void testReadMessagesStop() {
+    std::cout << "\n=== ReliableEndpoint Stop Test ===" << std::endl;
+
+    ReliableEndpoint sender;
+    ReliableEndpoint receiver;
+    for (int i = 0; i < 3; ++i) {
+        Packet message(PacketType::HEARTBEAT);
+        message.write(static_cast<uint32_t>(i));
+        sender.send(i == 0 ? Channel::RELIABLE_ORDERED : Channel::UNRELIABLE_SEQUENCED, message);
+    }
+    const auto now = std::chrono::steady_clock::now();
+    Packet packet(PacketType::MESSAGES);
+    sender.writeMessages(packet, now);
+    sender.stampHeader(packet, now);
+    packet.resetRead();
+
+    int delivered = 0;
+    const bool valid = receiver.readMessages(packet, [&](Packet&) {
+        ++delivered;
+        receiver.reset();  // What closing the connection does to its endpoint
+        return false;
+    });
+    check(valid, "block accepted");
+    check(delivered == 1, "nothing delivered after deliver returned false");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Server Test ===" << std::endl;
+
+    testInputJitterBuffer();
+    testSipHash();
+    testConnectionGate();
+    testConnectRateLimit();
+    testConnectionTable();
+    testBitStream();
+    testSnapshotDelta();
+    testFragmentAssembler();
+    testAckWindow();
+    testReadMessagesStop();
+    testMessagesDisconnect();
+    testNestedContainers();
+
+    std::cout << "\n=== Test Complete: " << (failures == 0 ? "all passed" : "FAILURES") << " ===" << std::endl;
+    return failures == 0 ? 0 : 1;
+}